@@ -7,6 +7,7 @@
 #include <tuple>
 #include "Global.h"
 #include "Colors.h"
+#include "log_source.h"
 
 class GUI {
 private:
@@ -26,8 +27,12 @@ public:
     bool promptYesNo(const std::string& title, const std::string& prompt);
     void promptGraphInput(bool isDirected, int& numVertices, int& numEdges, std::vector<std::tuple<int, int, int>>& edges);
     void promptStartEnd(const std::string& title, int minValue, int maxValue, int& startValue, int& endValue);
-    void showAlgorithmLogs(const std::string& title, const std::vector<std::string>& logs);
+    void showGraphSummary(int numVertices, int numEdges, const std::vector<std::tuple<int, int, int>>& edges, bool isDirected);
+    void showAlgorithmLogs(const std::string& title, const std::vector<std::pair<int, std::string>>& logs);
+    // Lấy dòng từ source theo từng trang và chỉ ngắt dòng phần sắp hiển thị (event_trace.h)
+    void showAlgorithmLogs(const std::string& title, const LogSource& source);
     void showMessage(const std::string& title, const std::vector<std::string>& lines);
+    void showMessageColored(const std::string& title, const std::vector<std::pair<int, std::string>>& lines);
     void waitForKey();
 };
 
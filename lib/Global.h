@@ -15,7 +15,22 @@ enum class AppState {
 enum class AlgorithmType {
     DIJKSTRA,
     BELLMAN_FORD,
-    BOTH
+    BOTH,
+    DIJKSTRA_CSR,
+    BELLMAN_FORD_CSR,
+    DIJKSTRA_DARY_HEAP,
+    DIJKSTRA_PAIRING_HEAP,
+    DIJKSTRA_DIAL,
+    ZERO_ONE_BFS,
+    DIJKSTRA_AUTO,
+    DIJKSTRA_RADIX_HEAP,
+    DELTA_STEPPING,
+    CONTRACTION_HIERARCHY,
+    DIJKSTRA_JOHNSON,
+    BELLMAN_FORD_SPFA,
+    GOLDBERG_RADZIK,
+    DIJKSTRA_BINARY_DARY_HEAP,  // IndexedDaryHeap<2>; DIJKSTRA_DARY_HEAP là bản 4-ary
+    DIJKSTRA_OCTAL_DARY_HEAP    // IndexedDaryHeap<8>
 };
 
 const std::string DATA_FOLDER = "../data";
@@ -6,6 +6,9 @@
 #include <utility>
 #include "Graph.h"
 
+class CsrGraph;
+class QueryWorkspace;
+class TraceSink;
 
 struct PathResult {
     bool success;
@@ -13,25 +16,153 @@ struct PathResult {
     std::vector<int> distances;
     std::vector<int> previousVertex;
     std::vector<int> shortestPath;
-    std::vector<std::string> logs;
+    std::vector<std::pair<int, std::string>> logs;
     bool hasNegativeCycle;
 
     PathResult() : success(false), startVertex(-1), hasNegativeCycle(false) {}
 };
 
+// Kết quả truy vấn một cặp đỉnh: chỉ khoảng cách và đường đi, không có mảng O(V)
+struct PointToPointResult {
+    bool found;
+    int distance;
+    std::vector<int> path;
+    int settledVertices;   // số đỉnh đã chốt (cả hai chiều nếu có)
+
+    PointToPointResult() : found(false), distance(-1), settledVertices(0) {}
+};
+
+// Kết quả truy vấn tới một tập đích: chỉ lưu thông tin của các đích, không có mảng O(V)
+struct TargetQueryResult {
+    bool success;
+    int source;
+    std::vector<int> targets;
+    std::vector<int> distances;            // distances[i] ứng với targets[i], -1 nếu không tới được
+    std::vector<std::vector<int>> paths;   // paths[i] rỗng nếu không tới được
+    int settledVertices;
+
+    TargetQueryResult() : success(false), source(-1), settledVertices(0) {}
+};
+
+// Thứ tự lấy đỉnh của SPFA (Algorithms::spfa)
+enum class SpfaQueue {
+    FIFO,       // hàng đợi thường
+    SLF,        // Small Label First: đỉnh mới có nhãn nhỏ hơn đầu hàng thì vào đầu hàng
+    LLL,        // Large Label Last: đầu hàng có nhãn lớn hơn trung bình thì chuyển xuống cuối
+    SLF_LLL
+};
+
 class Algorithms {
 private:
     const Graph& graph;
 
-    void logStep(std::vector<std::string>& logs, const std::string& message);
     std::vector<int> reconstructPath(int destination, const std::vector<int>& previousVertex) const;
 
+    // Trace: chính sách theo dõi (algorithms.cpp). Bản NoTrace không chứa mã log nào
+    template <typename Queue, typename Trace, typename Adjacency>
+    PathResult runDijkstra(const Adjacency& adj, int start, Trace& trace);
+    template <typename Trace, typename Adjacency>
+    PathResult runJohnson(const Adjacency& adj, int start, Trace& trace);
+    template <typename Trace, typename Adjacency>
+    PathResult runBellmanFord(const Adjacency& adj, int start, Trace& trace);
+    template <typename Adjacency>
+    PathResult runSpfa(const Adjacency& adj, int start, SpfaQueue discipline);
+    template <typename Adjacency>
+    PathResult runGoldbergRadzik(const Adjacency& adj, int start);
+    template <typename Adjacency>
+    PathResult runDial(const Adjacency& adj, int start, int maxWeight);
+    template <typename Adjacency>
+    PathResult runZeroOneBfs(const Adjacency& adj, int start);
+    // Cùng vòng lặp với hai hàm trên, nhãn ghi vào workspace thay vì PathResult
+    template <typename Adjacency>
+    int runDijkstra(const Adjacency& adj, int start, QueryWorkspace& workspace, int target) const;
+    template <typename Adjacency>
+    bool runBellmanFord(const Adjacency& adj, int start, QueryWorkspace& workspace) const;
+    template <typename Adjacency>
+    TargetQueryResult runDijkstraToTargets(const Adjacency& adj, int source, const std::vector<int>& targets) const;
+
 public:
     explicit Algorithms(const Graph& g);
 
     PathResult dijkstra(int start, bool showSteps = false);
+    // Chạy trên ảnh chụp CSR của cùng đồ thị (nhãn đỉnh vẫn lấy từ graph)
+    PathResult dijkstra(const CsrGraph& csr, int start, bool showSteps = false);
+    // Gửi từng sự kiện (chốt đỉnh, cập nhật, ...) tới sink thay vì ghi log chữ (trace.h)
+    PathResult dijkstra(int start, TraceSink& sink);
+    // Dijkstra với hàng đợi ưu tiên tùy chọn (priority_queues.h):
+    // BinaryHeapQueue (mặc định), IndexedDaryHeap<2/4/8>, PairingHeap,
+    // RadixHeap (chỉ cho trọng số không âm)
+    template <typename Queue>
+    PathResult dijkstraWith(int start, bool showSteps = false);
+    template <typename Queue>
+    PathResult dijkstraWith(const CsrGraph& csr, int start, bool showSteps = false);
+
+    // Dial: mảng bucket vòng kích thước (trọng số lớn nhất + 1), O(V + E + C).
+    // Chỉ dùng cho trọng số nguyên không âm; không ghi log từng bước.
+    PathResult dialDijkstra(int start);
+    PathResult dialDijkstra(const CsrGraph& csr, int start);
+    // 0-1 BFS bằng deque cho đồ thị chỉ có trọng số 0 và 1, O(V + E)
+    PathResult zeroOneBfs(int start);
+    PathResult zeroOneBfs(const CsrGraph& csr, int start);
+
+    // Chọn engine theo khoảng trọng số: ZERO_ONE_BFS, DIJKSTRA_DIAL, DIJKSTRA_RADIX_HEAP
+    // (trọng số không âm quá rộng cho Dial) hoặc DIJKSTRA (có trọng số âm)
+    AlgorithmType chooseDijkstraEngine() const;
+    AlgorithmType chooseDijkstraEngine(const CsrGraph& csr) const;
+    // Khi showSteps = true luôn dùng Dijkstra gốc để log từng bước như cũ
+    PathResult dijkstraAuto(int start, bool showSteps = false);
+    PathResult dijkstraAuto(const CsrGraph& csr, int start);
+
+    // Dijkstra (trọng số không âm) dừng ngay khi mọi đỉnh trong `targets` đã được chốt; nhãn chỉ lưu cho
+    // các đỉnh đã chạm tới (bảng băm) nên chi phí theo vùng tìm kiếm, không theo V
+    TargetQueryResult dijkstraToTargets(int source, const std::vector<int>& targets) const;
+    TargetQueryResult dijkstraToTargets(const CsrGraph& csr, int source, const std::vector<int>& targets) const;
+
+    // Dijkstra hai chiều cho truy vấn source -> target (trọng số không âm).
+    // Dừng khi đỉnh đầu hai hàng đợi cộng lại >= độ dài đường tốt nhất đã gặp.
+    // `backward` là forward.reversed(); bản không tham số tự dựng cả hai ảnh chụp.
+    PointToPointResult bidirectionalDijkstra(const CsrGraph& forward, const CsrGraph& backward,
+                                             int source, int target) const;
+    PointToPointResult bidirectionalDijkstra(int source, int target) const;
+
+    // Johnson: Dijkstra trên trọng số rút gọn w + h(u) - h(v) với thế năng lưu trong graph
+    // (Graph::getPotentials), rồi đổi khoảng cách về giá trị gốc. Bellman-Ford chỉ chạy lần đầu
+    // cho mỗi phiên bản đồ thị. Có chu trình âm (hoặc thế năng tràn int): trả về bellmanFord(start).
+    // Khi showSteps = true, khoảng cách trong log là khoảng cách rút gọn.
+    PathResult johnsonDijkstra(int start, bool showSteps = false);
+    PathResult johnsonDijkstra(const CsrGraph& csr, int start);
+    PathResult johnsonDijkstra(int start, TraceSink& sink);
 
     PathResult bellmanFord(int start, bool showSteps = false);
+    PathResult bellmanFord(const CsrGraph& csr, int start, bool showSteps = false);
+    PathResult bellmanFord(int start, TraceSink& sink);
+
+    // SPFA (Bellman-Ford theo hàng đợi): chỉ duyệt cạnh ra của các đỉnh vừa đổi khoảng cách.
+    // Cây đường đi ngắn nhất được giữ theo thứ tự tiền tự kèm độ sâu; khi khoảng cách của v giảm,
+    // cả cây con của v bị tháo ra (các đỉnh trong đó rời hàng đợi vì nhãn của chúng chắc chắn còn giảm),
+    // và nếu u - đỉnh đang duyệt - nằm trong cây con đó thì có chu trình âm (Tarjan), dừng ngay.
+    // Khi không có chu trình âm, distances giống bellmanFord; khi có thì hasNegativeCycle = true,
+    // success = false như bellmanFord nhưng distances là giá trị tại lúc phát hiện.
+    PathResult spfa(int start, SpfaQueue discipline = SpfaQueue::FIFO);
+    PathResult spfa(const CsrGraph& csr, int start, SpfaQueue discipline = SpfaQueue::FIFO);
+
+    // Goldberg-Radzik: mỗi lượt lấy các đỉnh của tập B có cung với chi phí rút gọn d(u) + w - d(v) < 0,
+    // sắp xếp tô-pô phần đồ thị "chấp nhận được" (chi phí rút gọn <= 0) đi tới từ chúng bằng DFS,
+    // rồi duyệt theo thứ tự đó; các đỉnh đổi khoảng cách thành B của lượt sau. Tối đa V lượt khi không
+    // có chu trình âm. Cung ngược có chi phí rút gọn âm trong DFS là một chu trình âm, dừng ngay;
+    // quá V lượt cũng là có chu trình âm. PathResult như spfa.
+    PathResult goldbergRadzik(int start);
+    PathResult goldbergRadzik(const CsrGraph& csr, int start);
+
+    // Bản dùng lại bộ nhớ (query_workspace.h): kết quả nằm trong workspace (distance, previous, path),
+    // chi phí khởi tạo chỉ theo số đỉnh đã chạm chứ không theo V. Mỗi luồng truyền workspace riêng.
+    // Dijkstra (trọng số không âm): target >= 0 thì dừng khi target được chốt; trả về số đỉnh đã chốt
+    int dijkstra(int start, QueryWorkspace& workspace, int target = -1) const;
+    int dijkstra(const CsrGraph& csr, int start, QueryWorkspace& workspace, int target = -1) const;
+    // Bellman-Ford chỉ duyệt cạnh ra của các đỉnh đã chạm tới, dừng sớm khi một lượt không cập nhật.
+    // false nếu có chu trình âm tới được từ start
+    bool bellmanFord(int start, QueryWorkspace& workspace) const;
+    bool bellmanFord(const CsrGraph& csr, int start, QueryWorkspace& workspace) const;
 
     std::vector<int> getShortestPath(const PathResult& result, int destination) const;
 
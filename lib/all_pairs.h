@@ -0,0 +1,42 @@
+#ifndef ALL_PAIRS_H
+#define ALL_PAIRS_H
+
+#include <vector>
+#include "csr_graph.h"
+#include "Graph.h"
+
+// Đường đi ngắn nhất mọi cặp đỉnh: một lần Dijkstra cho mỗi nguồn, các luồng lấy nguồn kế tiếp
+// từ một bộ đếm chung nên luồng xong sớm tự nhận thêm việc. Có trọng số âm thì dùng thế năng
+// Johnson của graph (Graph::getPotentials) và chạy Dijkstra trên trọng số rút gọn.
+// Kết quả là ma trận liên tiếp theo dòng: distance(s, t) = distances[s * V + t].
+class AllPairsShortestPaths {
+private:
+    const Graph& graph;
+    int V;
+    bool hasNegativeCycle;
+    std::vector<int> distances;     // V * V, INF nếu không tới được
+    std::vector<int> nextHops;      // V * V, đỉnh ngay sau s trên đường s -> t, -1 nếu không có
+
+public:
+    explicit AllPairsShortestPaths(const Graph& g);
+
+    // threads <= 0: std::thread::hardware_concurrency(). withNextHop = false bỏ ma trận đỉnh kế
+    // (giảm một nửa bộ nhớ). false nếu đồ thị rỗng hoặc có chu trình âm.
+    bool run(int threads = 0, bool withNextHop = true);
+
+    bool isComputed() const { return !distances.empty(); }
+    bool hasNextHops() const { return !nextHops.empty(); }
+    bool foundNegativeCycle() const { return hasNegativeCycle; }
+    int getVertexCount() const { return V; }
+
+    int distance(int source, int target) const { return distances[static_cast<size_t>(source) * V + target]; }
+    int nextHop(int source, int target) const { return nextHops[static_cast<size_t>(source) * V + target]; }
+    const int* row(int source) const { return distances.data() + static_cast<size_t>(source) * V; }
+    const std::vector<int>& getDistances() const { return distances; }
+
+    // Dựng đường đi từ ma trận đỉnh kế; rỗng nếu không tới được hoặc chưa có next-hop
+    std::vector<int> path(int source, int target) const;
+    long long memoryUsageBytes() const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef ALT_LANDMARKS_H
+#define ALT_LANDMARKS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr_graph.h"
+#include "Algorithms.h"
+#include "Graph.h"
+
+// Cách chọn landmark:
+// FARTHEST: lần lượt lấy đỉnh xa nhất so với các landmark đã chọn
+// AVOID: heuristic "avoid" của Goldberg & Werneck, ưu tiên vùng cây đường đi ngắn nhất
+//        mà các landmark hiện có cho cận dưới kém nhất
+enum class LandmarkSelection {
+    FARTHEST,
+    AVOID
+};
+
+// ALT = A* + landmark + bất đẳng thức tam giác, cho nhiều truy vấn cặp đỉnh trên cùng đồ thị
+// (trọng số không âm). Với mỗi landmark L lưu d(L, v) và d(v, L); cận dưới
+//   d(v, t) >= max(d(L, t) - d(L, v), d(v, L) - d(t, L))
+// là thế vị nhất quán, nên A* chốt mỗi đỉnh đúng một lần như Dijkstra.
+class AltIndex {
+private:
+    int V;
+    int E;
+    int landmarkCount;
+    std::uint64_t fingerprint;          // băm nội dung CSR, để phát hiện file .alt cũ
+    std::vector<int> landmarks;
+    std::vector<int> fromLandmark;      // [v * k + i] = d(landmarks[i], v), INF nếu không tới được
+    std::vector<int> toLandmark;        // [v * k + i] = d(v, landmarks[i])
+
+public:
+    AltIndex();
+
+    // Chọn `count` landmark và dựng hai bảng khoảng cách bằng Dijkstra sẵn có.
+    // false nếu đồ thị rỗng hoặc có trọng số âm.
+    bool build(const Graph& graph, int count = 8, LandmarkSelection selection = LandmarkSelection::AVOID);
+
+    // File nhị phân đặt cạnh file đồ thị (xem pathFor); load trả về false nếu file
+    // không hợp lệ hoặc được dựng cho đồ thị khác
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename, const CsrGraph& csr);
+    static std::string pathFor(const std::string& graphFile) { return graphFile + ".alt"; }
+
+    bool isBuilt() const { return landmarkCount > 0; }
+    int getLandmarkCount() const { return landmarkCount; }
+    const std::vector<int>& getLandmarks() const { return landmarks; }
+    long long memoryUsageBytes() const;
+
+    // Cận dưới của d(v, target); INF khi chắc chắn v không tới được target
+    int lowerBound(int v, int target) const;
+
+    PointToPointResult query(const CsrGraph& csr, int source, int target) const;
+};
+
+#endif
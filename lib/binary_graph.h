@@ -0,0 +1,65 @@
+#ifndef BINARY_GRAPH_H
+#define BINARY_GRAPH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "graph.h"
+#include "csr_graph.h"
+#include "mapped_file.h"
+
+// Định dạng nhị phân của đồ thị (little-endian), mọi phần được căn lề 64 byte:
+//   header | offsets (V+1 x int32) | targets (E x int32) | weights (E x int32)
+//          | labelOffsets (V+1 x uint32) | labelBlob (các nhãn nối liền, không có '\0')
+// checksum là FNV-1a 64 bit trên toàn bộ phần dữ liệu phía sau header.
+constexpr char BINARY_GRAPH_MAGIC[8] = {'P', 'B', 'L', 'G', 'R', 'A', 'P', 'H'};
+constexpr std::uint32_t BINARY_GRAPH_VERSION = 1;
+constexpr std::uint32_t BINARY_GRAPH_ENDIAN_TAG = 0x01020304u;
+
+struct BinaryGraphHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::int64_t vertexCount;
+    std::int64_t edgeCount;
+    std::uint64_t offsetsPos;
+    std::uint64_t targetsPos;
+    std::uint64_t weightsPos;
+    std::uint64_t labelOffsetsPos;
+    std::uint64_t labelBlobPos;
+    std::uint64_t labelBlobBytes;
+    std::uint64_t fileBytes;
+    std::uint64_t checksum;
+    std::uint8_t reserved[32];
+};
+static_assert(sizeof(BinaryGraphHeader) == 128, "BinaryGraphHeader must stay 128 bytes");
+
+bool writeBinaryGraph(const Graph& graph, const std::string& filename);
+
+// Mở file nhị phân bằng mmap: không sao chép, không phân tích cú pháp.
+// csr() trỏ thẳng vào vùng nhớ đã ánh xạ, nên truy vấn có thể chạy ngay sau open().
+class BinaryGraphFile {
+private:
+    std::shared_ptr<MappedFile> mapping;
+    const BinaryGraphHeader* header;
+    const std::uint32_t* labelOffsets;
+    const char* labelBlob;
+    CsrGraph snapshot;
+
+public:
+    BinaryGraphFile();
+
+    // open() luôn kiểm tra cấu trúc (O(V + E) trên offsets/targets, không đụng tới trọng số);
+    // verifyChecksum = true đọc thêm toàn bộ file để phát hiện trọng số/nhãn bị hỏng
+    bool open(const std::string& filename, bool verifyChecksum = false);
+    void close();
+    bool isOpen() const;
+    bool verifyChecksum() const;
+
+    const CsrGraph& csr() const { return snapshot; }
+    int getVertexCount() const { return snapshot.getVertexCount(); }
+    int getEdgeCount() const { return snapshot.getEdgeCount(); }
+    std::string getVertexLabel(int vertex) const;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <memory>
 #include "Algorithms.h"
 #include "Graph.h"
 
@@ -31,16 +32,62 @@ struct ComparisonReport {
     ComparisonReport() : startVertex(-1), V(0), E(0) {}
 };
 
+class AltIndex;
+class ContractionHierarchy;
+class HubLabels;
+
 class Comparison {
 private:
     const Graph& graph;
     Algorithms algorithms;
+    // CH dựng lần đầu cần đến rồi dùng lại cho mọi lần đo; buildUs là thời gian dựng
+    std::shared_ptr<ContractionHierarchy> hierarchy;
+    unsigned long long hierarchyVersion;  // Graph::getVersion() lúc dựng hierarchy
+    long long hierarchyBuildUs;
+
+    const ContractionHierarchy& contractionHierarchy();
+    // Thời gian Bellman-Ford tính thế năng Johnson (tiền xử lý, đo riêng; các dòng Johnson chỉ tính truy vấn)
+    long long measurePotentials();
 
 public:
     explicit Comparison(const Graph& g);
 
     ComparisonReport comparePerformance(int startVertex, AlgorithmType type = AlgorithmType::BOTH);
 
+    // Bảng so sánh nhiều engine, mỗi engine chạy `repeats` lần và lấy trung bình.
+    // Dòng đầu tiên là mốc để tính tỉ lệ tăng tốc.
+    ComparisonReport compareEngines(int startVertex, const std::vector<AlgorithmType>& types, int repeats = 5);
+
+    // Tốc độ đọc file văn bản (MB/s): bộ đọc song song so với bộ đọc ifstream cũ
+    static ComparisonReport benchmarkParsers(const std::vector<std::string>& files, int repeats = 3);
+    // Như trên trên file văn bản của đồ thị ngẫu nhiên (generateRandomGraph, V = E / 8) với số cạnh cho trước,
+    // ghi vào thư mục tạm rồi xóa sau khi đo
+    static ComparisonReport benchmarkSyntheticParsers(const std::vector<int>& edgeCounts, int repeats = 1);
+
+    // Delta-stepping với số luồng khác nhau; tăng tốc tính so với Dijkstra tuần tự
+    ComparisonReport benchmarkThreadScaling(int startVertex, const std::vector<int>& threadCounts, int delta = 0);
+
+    // Ma trận khoảng cách mọi cặp đỉnh (AllPairsShortestPaths) với số luồng khác nhau, so với
+    // gọi Algorithms::dijkstra (johnsonDijkstra nếu có trọng số âm) lần lượt cho từng nguồn;
+    // dòng cuối là Floyd-Warshall chia khối trên ma trận dày (BlockedFloydWarshall)
+    ComparisonReport benchmarkAllPairs(const std::vector<int>& threadCounts);
+
+    // Truy vấn cặp đỉnh ngẫu nhiên: Dijkstra một nguồn đầy đủ, dừng tại đích (cấp phát mới và dùng lại
+    // QueryWorkspace), hai chiều, ALT, CH và CCH;
+    // in thời gian, số đỉnh đã chốt trung bình và tăng tốc so với Algorithms::dijkstra.
+    // alt = nullptr: tự dựng chỉ mục ALT (thời gian dựng in riêng).
+    // withHierarchy = false: bỏ CH và CCH (đồ thị ngẫu nhiên không có phân cấp, co đỉnh rất chậm)
+    ComparisonReport benchmarkPointToPoint(int queryCount, unsigned seed = 1, const AltIndex* alt = nullptr,
+                                           bool withHierarchy = true);
+
+    // Oracle khoảng cách bằng nhãn hub: thời gian dựng, kích thước nhãn, ns/truy vấn (chỉ khoảng cách
+    // và có đường đi) so với Dijkstra một nguồn và Dijkstra hai chiều trên cùng các cặp đỉnh.
+    // labels = nullptr: tự dựng (thời gian dựng in riêng)
+    ComparisonReport benchmarkHubLabels(int queryCount, unsigned seed = 1, const HubLabels* labels = nullptr);
+
+    static std::vector<AlgorithmType> registeredEngines();
+    static std::string engineName(AlgorithmType type);
+
     PerformanceMetrics measureAlgorithm(int startVertex, AlgorithmType type);
 };
 
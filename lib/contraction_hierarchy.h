@@ -0,0 +1,53 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include "Algorithms.h"
+#include "Graph.h"
+
+// Contraction Hierarchies (Geisberger và cộng sự) cho trọng số không âm.
+// Tiền xử lý: lần lượt co đỉnh theo độ ưu tiên "edge difference" (số shortcut cần thêm
+// trừ số cạnh bị bỏ, cộng số láng giềng đã co), tìm witness bằng Dijkstra cục bộ có giới hạn,
+// thêm shortcut u -> w qua v khi không có đường vòng nào ngắn hơn.
+// Truy vấn: hai lượt Dijkstra chỉ đi lên (theo thứ hạng) từ source và target, rồi mở shortcut.
+class ContractionHierarchy {
+private:
+    int V;
+    int shortcutCount;
+    std::vector<int> rank;              // thứ tự co của đỉnh
+    std::vector<int> order;             // order[r] = đỉnh có thứ hạng r
+    // Cung đi lên u -> v (rank[u] < rank[v]) lưu ở u
+    std::vector<int> upOffsets;
+    std::vector<int> upTargets;
+    std::vector<int> upWeights;
+    std::vector<int> upMiddles;         // -1: cạnh gốc, ngược lại: đỉnh đã co mà shortcut đi qua
+    // Cung đi xuống u -> v (rank[u] > rank[v]) lưu ở v dưới dạng v <- u, dùng cho lượt tìm ngược
+    std::vector<int> downOffsets;
+    std::vector<int> downSources;
+    std::vector<int> downWeights;
+    std::vector<int> downMiddles;
+
+    bool findArc(int from, int to, int& weight, int& middle) const;
+    bool unpackArc(int from, int to, std::vector<int>& path) const;
+
+public:
+    ContractionHierarchy();
+
+    // false nếu đồ thị rỗng hoặc có trọng số âm
+    bool build(const Graph& graph);
+
+    bool isBuilt() const { return V > 0; }
+    int getVertexCount() const { return V; }
+    int getShortcutCount() const { return shortcutCount; }
+    long long memoryUsageBytes() const;
+
+    // Truy vấn cặp đỉnh, trả về đường đi đã mở shortcut
+    PointToPointResult pointToPoint(int source, int target) const;
+    // Cùng truy vấn nhưng dưới dạng PathResult để dùng với Algorithms::getShortestPath/getDistance
+    // (chỉ các đỉnh trên đường đi có khoảng cách, còn lại là INF)
+    PathResult query(int source, int target) const;
+    // Một nguồn tới mọi đỉnh (PHAST): lượt đi lên từ start rồi quét xuống theo thứ hạng giảm dần
+    PathResult run(int start) const;
+};
+
+#endif
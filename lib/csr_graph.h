@@ -0,0 +1,44 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <memory>
+#include <vector>
+#include "graph.h"
+
+// Ảnh chụp bất biến của Graph dạng CSR (compressed sparse row):
+// cạnh đi ra của đỉnh u nằm liên tiếp trong [offsets[u], offsets[u + 1]).
+// Thứ tự cạnh giữ nguyên như trong adjList nên kết quả thuật toán không đổi.
+// Dữ liệu có thể nằm trong bộ nhớ tự cấp phát hoặc trong một vùng nhớ ngoài
+// (ví dụ file đã mmap); `storage` giữ vùng nhớ đó sống cùng ảnh chụp.
+class CsrGraph {
+private:
+    int V;
+    int E;
+    const int* offsets;
+    const int* targets;
+    const int* weights;
+    std::shared_ptr<const void> storage;
+
+public:
+    CsrGraph();
+    explicit CsrGraph(const Graph& g);
+    // Không sao chép: các con trỏ phải sống ít nhất bằng `owner`
+    CsrGraph(int vertices, int edges, const int* offsetsData, const int* targetsData,
+             const int* weightsData, std::shared_ptr<const void> owner);
+
+    int getVertexCount() const { return V; }
+    int getEdgeCount() const { return E; }
+    int degree(int u) const { return offsets[u + 1] - offsets[u]; }
+
+    const int* getOffsets() const { return offsets; }
+    const int* getTargets() const { return targets; }
+    const int* getWeights() const { return weights; }
+
+    // Đồ thị ngược (mỗi cung u -> v thành v -> u), dựng bằng counting sort O(V + E)
+    CsrGraph reversed() const;
+
+    bool getWeightRange(int& minWeight, int& maxWeight) const;
+    long long memoryUsageBytes() const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef CUSTOMIZABLE_CH_H
+#define CUSTOMIZABLE_CH_H
+
+#include <vector>
+#include "Algorithms.h"
+#include "Graph.h"
+
+// Customizable Contraction Hierarchies (Dibbelt, Strasser, Wagner) cho trọng số không âm.
+// prepare(): chỉ dùng cấu trúc đồ thị (bỏ hướng và trọng số). Thứ tự co theo nested dissection
+// (tách đôi bằng một tầng BFS làm tập cắt, tập cắt nhận thứ hạng cao nhất), rồi co hình thức
+// để được đồ thị chordal: các láng giềng hạng cao hơn của mỗi đỉnh luôn đôi một kề nhau.
+// customize(): gán trọng số mới cho đúng cấu trúc đó, xử lý mọi tam giác dưới; các đỉnh cùng tầng
+// trên cây khử chỉ ghi cung của chính mình nên chạy song song không cần khóa.
+// Truy vấn: đi lên theo cây khử từ source và từ target, không cần hàng đợi ưu tiên.
+// Mọi mảng bên trong đánh số theo thứ hạng (rank), không theo đỉnh gốc.
+class CustomizableCH {
+private:
+    int V;
+    bool customized;
+    int treeHeight;
+    std::vector<int> rank;              // rank[v] = thứ hạng của đỉnh v
+    std::vector<int> order;             // order[r] = đỉnh có thứ hạng r
+    std::vector<int> parent;            // cha trên cây khử (-1 ở gốc) = láng giềng trên có hạng nhỏ nhất
+    // Cung lên r -> u (r < u), sắp theo u tăng dần
+    std::vector<int> upOffsets;
+    std::vector<int> upHeads;
+    // Cung xuống: với mỗi u, các r < u có cung r -> u và chỉ số cung đó trong mảng lên
+    std::vector<int> downOffsets;
+    std::vector<int> downTails;
+    std::vector<int> downArcs;
+    // Các đỉnh theo tầng trên cây khử (tầng 0 là lá), để tùy biến song song
+    std::vector<int> levelOffsets;
+    std::vector<int> levelVertices;
+    // Trọng số theo từng cung lên r -> u: forward = w(r -> u), backward = w(u -> r), INF nếu không có
+    std::vector<int> forwardWeights;
+    std::vector<int> backwardWeights;
+    std::vector<int> forwardMiddles;    // -1: cạnh gốc, ngược lại: thứ hạng của đỉnh ở giữa
+    std::vector<int> backwardMiddles;
+
+    int findArc(int lower, int upper) const;
+    void unpackArc(int from, int to, std::vector<int>& path) const;
+    void customizeVertex(int u);
+
+public:
+    CustomizableCH();
+
+    // Pha không phụ thuộc trọng số, chỉ chạy lại khi cấu trúc đồ thị đổi. false nếu đồ thị rỗng.
+    bool prepare(const Graph& graph);
+    // Áp trọng số hiện tại của graph. false nếu chưa prepare, có trọng số âm hoặc graph có cạnh
+    // không nằm trong cấu trúc đã chuẩn bị. threads <= 0: std::thread::hardware_concurrency()
+    bool customize(const Graph& graph, int threads = 0);
+
+    bool isPrepared() const { return V > 0; }
+    bool isCustomized() const { return customized; }
+    int getVertexCount() const { return V; }
+    int getArcCount() const { return static_cast<int>(upHeads.size()); }
+    int getTreeHeight() const { return treeHeight; }
+    long long memoryUsageBytes() const;
+
+    PointToPointResult pointToPoint(int source, int target) const;
+    // Cùng truy vấn dưới dạng PathResult để dùng với Algorithms::getShortestPath/getDistance
+    PathResult query(int source, int target) const;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <vector>
+#include "csr_graph.h"
+#include "Algorithms.h"
+
+// Delta-stepping song song (Meyer & Sanders) cho trọng số không âm.
+// Khoảng cách chia vào các bucket rộng delta; cạnh nhẹ (w <= delta) được nới lặp lại
+// trong bucket hiện tại, cạnh nặng chỉ nới một lần khi bucket đã xong.
+// Đỉnh v do luồng v % T sở hữu: luồng nới cạnh tới v gửi v vào bucket của chủ, nên việc
+// chốt đỉnh chia đều cho các luồng. Khoảng cách và đỉnh trước được gộp vào một số 64 bit
+// và cập nhật bằng CAS nên luôn nhất quán với nhau.
+// Khoảng cách giống hệt Dijkstra; khi có nhiều đường ngắn nhất bằng nhau, previousVertex
+// có thể chọn đỉnh trước khác nhưng vẫn là một cây đường đi ngắn nhất hợp lệ.
+class DeltaStepping {
+private:
+    int V;
+    int delta;
+    int threadCount;
+    int maxWeight;
+    bool valid;
+    std::vector<int> lightOffsets;
+    std::vector<int> lightTargets;
+    std::vector<int> lightWeights;
+    std::vector<int> heavyOffsets;
+    std::vector<int> heavyTargets;
+    std::vector<int> heavyWeights;
+
+public:
+    // delta <= 0: tự chọn theo trọng số lớn nhất và bậc trung bình
+    // threads <= 0: std::thread::hardware_concurrency()
+    explicit DeltaStepping(const CsrGraph& csr, int delta = 0, int threads = 0);
+
+    // false nếu đồ thị có trọng số âm
+    bool isValid() const { return valid; }
+    int getDelta() const { return delta; }
+    int getThreadCount() const { return threadCount; }
+
+    // settledPerThread (nếu có) nhận số lần chốt đỉnh của từng luồng
+    PathResult run(int start, std::vector<int>* settledPerThread = nullptr) const;
+};
+
+#endif
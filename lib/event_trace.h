@@ -0,0 +1,100 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "log_source.h"
+#include "trace.h"
+
+// Bản ghi nhị phân của một lần chạy có theo dõi: mỗi sự kiện 16 byte, chỉ lưu phần thay đổi
+// (đỉnh được cập nhật và khoảng cách mới), không lưu bảng khoảng cách. Chữ chỉ được dựng khi
+// GUI hỏi tới một trang: trạng thái khoảng cách tại đó được dựng lại từ ảnh chụp gần nhất
+// trước nó rồi phát lại các sự kiện qua StepLogSink, nên nội dung giống hệt log chữ cũ.
+// Sự kiện gom theo khối; vượt memoryLimit thì các khối (và ảnh chụp) được đổ ra file tạm
+// và chỉ đọc lại khối cần cho trang đang xem.
+class EventTrace : public TraceSink, public LogSource {
+public:
+    enum class Kind : std::uint8_t {
+        BEGIN, ROUND_BEGIN, SETTLE, RELAX, ROUND_END, CYCLE_CHECK, CYCLE_EDGE,
+        FINISH, REWEIGHTED, SET_DISTANCE, RESTORED
+    };
+
+    struct Event {
+        Kind kind;
+        std::uint8_t flag;      // ROUND_END: có cập nhật; FINISH: có chu trình âm; BEGIN: engine
+        std::uint16_t reserved;
+        std::int32_t a;
+        std::int32_t b;
+        std::int32_t c;
+    };
+
+    static constexpr size_t CHUNK_EVENTS = 4096;
+
+private:
+    struct Chunk {
+        std::vector<Event> events;
+        long long fileOffset = -1;      // >= 0: đã đổ ra file, events rỗng
+        std::uint64_t firstLine = 0;
+        AlgorithmType engine = AlgorithmType::DIJKSTRA;
+        size_t snapshot = 0;            // ảnh chụp khoảng cách gần nhất có chunk <= chunk này
+    };
+    struct Snapshot {
+        size_t chunk = 0;               // trạng thái ngay trước sự kiện đầu của chunk này
+        std::vector<int> distances;
+        long long fileOffset = -1;
+    };
+
+    const Graph& graph;
+    int V;
+    size_t memoryLimit;
+    size_t snapshotEvery;               // số chunk giữa hai ảnh chụp, để ảnh chụp không lớn hơn sự kiện
+    std::vector<Chunk> chunks;
+    std::vector<Snapshot> snapshots;
+    std::vector<int> current;           // khoảng cách theo các sự kiện đã ghi
+    AlgorithmType engine;
+    std::uint64_t totalLines;
+    size_t eventCount;
+    size_t residentBytes;
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> spill;
+
+    // Đọc lại khối đã đổ ra file (một khối đệm)
+    mutable size_t cachedChunk;
+    mutable std::vector<Event> cachedEvents;
+
+    void record(Kind kind, int a = 0, int b = 0, int c = 0, std::uint8_t flag = 0);
+    size_t linesOf(const Event& e, AlgorithmType engineAt) const;
+    void openChunk();
+    void spillResident();
+    // Phát lại một sự kiện: cập nhật khoảng cách và (nếu sink != nullptr) dựng chữ
+    void replay(const Event& e, std::vector<int>& distances, AlgorithmType& engineAt, StepLogSink* sink) const;
+    const std::vector<Event>& chunkEvents(size_t index) const;
+    std::vector<int> snapshotDistances(size_t index) const;
+
+public:
+    // memoryLimit: số byte sự kiện + ảnh chụp giữ trong RAM trước khi đổ ra file tạm
+    explicit EventTrace(const Graph& g, size_t memoryLimit = 64u << 20);
+
+    // TraceSink
+    void begin(AlgorithmType type, int start) override;
+    void beginRound(int round, int totalRounds) override;
+    void settle(int round, int vertex, int distance) override;
+    void relax(int from, int to, int distance) override;
+    void endRound(int round, bool updated, const std::vector<int>& distances) override;
+    void beginCycleCheck() override;
+    void negativeCycleEdge(int from, int to, int weight) override;
+    void finish(const std::vector<int>& distances, bool hasNegativeCycle) override;
+    void reweighted(int bellmanFordPasses) override;
+    void restored(const std::vector<int>& distances) override;
+
+    // LogSource
+    size_t lineCount() const override { return static_cast<size_t>(totalLines); }
+    void lines(size_t first, size_t count, std::vector<std::pair<int, std::string>>& out) const override;
+
+    size_t getEventCount() const { return eventCount; }
+    bool isSpilled() const { return spill != nullptr; }
+    long long memoryUsageBytes() const { return static_cast<long long>(residentBytes); }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef FLOYD_WARSHALL_H
+#define FLOYD_WARSHALL_H
+
+#include <vector>
+#include "Graph.h"
+
+// Floyd-Warshall chia khối (Venkataraman và cộng sự) cho đồ thị dày: ma trận kề dựng trực tiếp
+// từ danh sách kề, đệm lên bội số của kích thước khối B. Với mỗi khối k:
+//   1. khối chéo (k, k) tự cập nhật,  2. các khối cùng dòng/cột k,  3. mọi khối còn lại,
+// nên mỗi lượt chỉ chạm ba khối B x B nằm gọn trong cache. Nhân min-plus dùng AVX2
+// (_mm256_add/min_epi32) khi biên dịch với -mavx2, ngược lại là vòng lặp thường để trình dịch
+// tự vector hóa. Chỉ tính khoảng cách (không có next-hop).
+// Trọng số âm: mọi giá trị được chặn dưới nên không tràn số; phát hiện chu trình âm khi
+// đường chéo âm sau một khối k và dừng ngay.
+class BlockedFloydWarshall {
+private:
+    const Graph& graph;
+    int V;
+    int tileSize;
+    bool hasNegativeCycle;
+    std::vector<int> distances;     // V * V theo dòng, INF (INT_MAX) nếu không tới được
+
+public:
+    explicit BlockedFloydWarshall(const Graph& g);
+
+    // tile <= 0: tự chọn kích thước khối nhanh nhất trên máy này (đo một lần, dùng lại).
+    // false nếu đồ thị rỗng, có chu trình âm, hoặc trọng số quá lớn cho ma trận int.
+    bool run(int tile = 0);
+
+    // Đo các kích thước khối ứng viên trên một ma trận ngẫu nhiên, trả về khối nhanh nhất
+    static int autotuneTileSize();
+    static const std::vector<int>& tileCandidates();
+    static bool usesAvx2();
+
+    bool isComputed() const { return !distances.empty(); }
+    bool foundNegativeCycle() const { return hasNegativeCycle; }
+    int getTileSize() const { return tileSize; }
+    int distance(int source, int target) const { return distances[static_cast<size_t>(source) * V + target]; }
+    const std::vector<int>& getDistances() const { return distances; }
+    long long memoryUsageBytes() const;
+};
+
+#endif
@@ -1,20 +1,58 @@
 #pragma once
+#include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 #include "Global.h"
 
+struct VertexPotentials;
+class CsrGraph;
+class BinaryGraphFile;
+
 struct Edge {
     int destination;
     int weight;
     Edge(int dest, int w) : destination(dest), weight(w) {}
 };
 
+// Cách xử lý cạnh trùng (cùng nguồn, cùng đích) khi nạp hàng loạt
+enum class DuplicatePolicy {
+    KEEP_LAST,  // giống addEdge: giữ vị trí cạnh đầu tiên, lấy trọng số cuối cùng
+    KEEP_MIN,   // giữ trọng số nhỏ nhất
+    REJECT      // có cạnh trùng thì không nạp gì cả
+};
+
 class Graph {
 private:
     int V;
     int E;
-    std::vector<std::vector<Edge>> adjList;
+    // Với đồ thị đọc từ file nhị phân, adjList chỉ được dựng lần đầu getAdjacencyList() được gọi
+    mutable std::vector<std::vector<Edge>> adjList;
     std::vector<std::string> vertexLabels;
+    // File nhị phân đã mmap (binary_graph.h) chứa cạnh và nhãn của đồ thị; rỗng với đồ thị thường.
+    // Thao tác sửa đầu tiên chép cạnh/nhãn ra adjList/vertexLabels rồi bỏ file
+    std::shared_ptr<const BinaryGraphFile> mapped;
+    // Thế năng Johnson (potentials.h), tính lần đầu getPotentials() được gọi.
+    // Mọi thao tác sửa cạnh/đỉnh đều xóa bộ đệm này
+    mutable std::shared_ptr<const VertexPotentials> potentials;
+    // Ảnh chụp CSR (csr_graph.h) của phiên bản hiện tại, dựng lần đầu getCsr() được gọi.
+    // Đồ thị đọc từ file nhị phân dùng thẳng vùng nhớ đã mmap, không dựng lại
+    mutable std::shared_ptr<const CsrGraph> csr;
+    mutable std::shared_ptr<const CsrGraph> reverseCsr;
+    // Tăng mỗi lần đồ thị bị sửa; bộ đệm nằm ngoài Graph so số này để biết phải dựng lại
+    unsigned long long version;
+
+    void invalidateCaches();
+    // Dựng adjList từ file đã mmap nếu chưa có
+    void ensureAdjacency() const;
+    // Gọi trước mọi thao tác sửa: chuyển đồ thị đọc từ file nhị phân sang adjList/vertexLabels
+    void detachMapping();
+    // Gọi visit(u, v, w) cho mọi cạnh theo thứ tự của adjList, không dựng adjList nếu đang dùng file
+    template <typename Visit>
+    void forEachEdge(Visit&& visit) const;
+    // Thêm thẳng vào danh sách kề các cạnh do forEachEdge(visit(u, v, w)) liệt kê (gọi hai lần)
+    template <typename ForEachEdge>
+    bool mergeEdges(const ForEachEdge& forEachEdge, DuplicatePolicy policy);
 
 public:
     Graph();
@@ -29,16 +67,38 @@ public:
     void clear();
     void addVertex(const std::string& label);
     void addEdge(int source, int destination, int weight);
+    // Nạp cả danh sách cạnh (chỉ số từ 0) trong một lượt O(V + E) thay vì gọi addEdge từng cạnh.
+    // Trả về false (đồ thị giữ nguyên) nếu policy là REJECT và có cạnh trùng.
+    bool addEdges(const std::vector<std::tuple<int, int, int>>& edges,
+                  DuplicatePolicy policy = DuplicatePolicy::KEEP_LAST);
     bool hasEdge(int source, int destination) const;
     void makeUndirected();
 
     bool fileExists(const std::string& filename) const;
     bool readFromFile(const std::string& filename, bool& needCreate);
+    bool readFromFileSequential(const std::string& filename, bool& needCreate);
     bool saveToFile(const std::string& filename) const;
+    // Định dạng nhị phân (xem binary_graph.h): không sao chép cạnh hay nhãn, getCsr() trỏ thẳng vào
+    // file đã mmap và các truy vấn mặc định của Algorithms chạy trên đó
+    bool readFromBinaryFile(const std::string& filename, bool& needCreate);
+    bool isFileBacked() const { return mapped != nullptr; }
+    bool saveToBinaryFile(const std::string& filename) const;
     bool exportForPython(const std::string& filename) const;
     bool exportForPython(const std::vector<int>& path) const;
     bool exportWithPath(const std::string& filename, const std::vector<int>& path) const;
 
     bool isValid() const;
     bool hasNegativeWeights() const;
+    // Trọng số nhỏ nhất/lớn nhất; false nếu đồ thị chưa có cạnh
+    bool getWeightRange(int& minWeight, int& maxWeight) const;
+
+    // Bellman-Ford chạy một lần cho mỗi phiên bản đồ thị; các lần sau trả về bản đã lưu
+    const VertexPotentials& getPotentials() const;
+    bool hasCachedPotentials() const { return potentials != nullptr; }
+    unsigned long long getVersion() const { return version; }
+
+    // CSR dùng chung cho các truy vấn; giữ nguyên tới khi đồ thị bị sửa
+    const CsrGraph& getCsr() const;
+    // Đồ thị ngược (getCsr().reversed()) cho các truy vấn hai chiều, cũng chỉ dựng một lần
+    const CsrGraph& getReverseCsr() const;
 };
@@ -0,0 +1,18 @@
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include "graph.h"
+
+// Đồ thị có hướng ngẫu nhiên để đo hiệu năng trên kích thước lớn hơn G1..G7.
+// Trọng số phân bố đều trong [minWeight, maxWeight]; cạnh trùng được gộp (KEEP_LAST)
+// nên số cạnh thực tế có thể ít hơn `edges` một chút. Cùng seed cho cùng đồ thị.
+void generateRandomGraph(Graph& graph, int vertices, int edges, int minWeight, int maxWeight,
+                         unsigned seed = 1);
+
+// Như trên nhưng có trọng số âm và không có chu trình âm: trọng số cạnh u -> v là
+// c + p(v) - p(u) với c đều trong [minWeight, maxWeight] (minWeight >= 0) và thế năng p ngẫu nhiên
+// trong [0, potentialRange], nên tổng trên mọi chu trình bằng tổng các c, không âm.
+void generateNegativeWeightGraph(Graph& graph, int vertices, int edges, int minWeight, int maxWeight,
+                                 int potentialRange, unsigned seed = 1);
+
+#endif
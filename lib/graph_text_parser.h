@@ -0,0 +1,46 @@
+#ifndef GRAPH_TEXT_PARSER_H
+#define GRAPH_TEXT_PARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Nội dung file văn bản dạng: V, V nhãn, E, rồi E bộ "u v w" (chỉ số từ 1)
+struct ParsedGraphText {
+    int vertexCount;
+    int declaredEdges;
+    std::vector<std::string> labels;
+    // Các số của phần cạnh, giữ nguyên bộ đệm của từng luồng (không gom lại);
+    // một bộ "u v w" có thể nằm vắt qua hai khối liền nhau
+    std::vector<std::vector<int>> blocks;
+    std::size_t edgeCount;
+
+    ParsedGraphText() : vertexCount(0), declaredEdges(0), edgeCount(0) {}
+
+    // Duyệt edgeCount cạnh theo thứ tự trong file, chỉ số đã đổi sang từ 0: visit(u, v, w)
+    template <typename Visit>
+    void forEachEdge(Visit visit) const {
+        int triple[3];
+        int filled = 0;
+        std::size_t emitted = 0;
+        for (const auto& block : blocks) {
+            for (int value : block) {
+                if (emitted == edgeCount) return;
+                triple[filled++] = value;
+                if (filled == 3) {
+                    visit(triple[0] - 1, triple[1] - 1, triple[2]);
+                    filled = 0;
+                    emitted++;
+                }
+            }
+        }
+    }
+};
+
+// Phân tích file đã nạp vào bộ nhớ. Phần header đọc tuần tự; phần cạnh được chia
+// thành các khối theo ranh giới dòng và đọc song song bằng std::from_chars.
+// threadCount <= 0 nghĩa là dùng std::thread::hardware_concurrency().
+// Trả về false khi thiếu số đỉnh hoặc số cạnh, giống Graph::readFromFile cũ.
+bool parseGraphText(const char* data, std::size_t size, ParsedGraphText& out, int threadCount = 0);
+
+#endif
@@ -14,6 +14,11 @@ void setcolor(int color);
 void setbkcolor(int color);
 void outtextxy(int x, int y, char *textstring);
 void rectangle(int left, int top, int right, int bottom);
+// Các hàm vẽ ghi vào khung hình trong bộ nhớ; swapbuffers() đưa phần thay đổi ra terminal
+// (getch() tự gọi trước khi chờ phím)
+void swapbuffers();
+// Terminal đã bị ghi bởi thứ khác (std::system, ...): lần swapbuffers() sau xóa và vẽ lại toàn bộ
+void invalidatedevice();
 
 int getch();
 
@@ -0,0 +1,95 @@
+#ifndef HUB_LABELS_H
+#define HUB_LABELS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "csr_graph.h"
+#include "Algorithms.h"
+#include "Graph.h"
+
+// Định dạng nhị phân của nhãn hub (little-endian), mọi phần căn lề 64 byte:
+//   header | order (V x int32: hạng hub -> đỉnh)
+//          | outOffsets (V+1 x uint64) | outHubs | outDists | outParents (tùy chọn)
+//          | inOffsets  (V+1 x uint64) | inHubs  | inDists  | inParents  (tùy chọn)
+// Nhãn của mỗi đỉnh nằm liền nhau, hub (uint32, theo hạng) tăng dần và kết thúc bằng
+// HUB_SENTINEL để vòng trộn không cần kiểm tra biên. Cùng một bố cục được dùng cả trong
+// bộ nhớ sau build() lẫn khi open() bằng mmap, nên truy vấn không phân biệt hai trường hợp.
+constexpr char HUB_LABELS_MAGIC[8] = {'P', 'B', 'L', 'H', 'U', 'B', 'L', 'B'};
+constexpr std::uint32_t HUB_LABELS_VERSION = 1;
+constexpr std::uint32_t HUB_SENTINEL = 0xFFFFFFFFu;
+
+struct HubLabelsHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t hasParents;
+    std::int64_t vertexCount;
+    std::int64_t edgeCount;
+    std::uint64_t fingerprint;          // băm nội dung CSR, để phát hiện file .hub cũ
+    std::uint64_t orderPos;
+    std::uint64_t outOffsetsPos;
+    std::uint64_t outHubsPos;
+    std::uint64_t outDistsPos;
+    std::uint64_t outParentsPos;
+    std::uint64_t inOffsetsPos;
+    std::uint64_t inHubsPos;
+    std::uint64_t inDistsPos;
+    std::uint64_t inParentsPos;
+    std::uint64_t fileBytes;
+    std::uint64_t reserved;
+};
+static_assert(sizeof(HubLabelsHeader) == 128, "HubLabelsHeader must stay 128 bytes");
+
+// Hub labeling bằng pruned landmark labeling (Akiba, Iwata, Yoshida) cho đồ thị có hướng,
+// trọng số không âm. Lần lượt theo thứ tự bậc giảm dần, mỗi hub h chạy Dijkstra xuôi và ngược
+// có cắt tỉa: đỉnh v mà nhãn hiện có đã cho d(h, v) (hoặc d(v, h)) thì không thêm h, không duyệt tiếp.
+//   out(v): các (h, d(v, h));  in(v): các (h, d(h, v))
+//   d(s, t) = min trên hub chung h của out(s)[h] + in(t)[h]
+// Parents (tùy chọn) lưu đỉnh kế tiếp trên đường v -> h và đỉnh đứng trước trên đường h -> v,
+// đủ để dựng lại đường đi mà không cần đồ thị.
+class HubLabels {
+private:
+    int V;
+    std::shared_ptr<const void> storage;    // khối nhớ tự cấp phát hoặc file đã mmap
+    const HubLabelsHeader* header;
+    const int* order;
+    const std::uint64_t* outOffsets;
+    const std::uint32_t* outHubs;
+    const int* outDists;
+    const int* outParents;
+    const std::uint64_t* inOffsets;
+    const std::uint32_t* inHubs;
+    const int* inDists;
+    const int* inParents;
+
+    bool attach(const char* base, std::uint64_t bytes, std::shared_ptr<const void> owner);
+    // Vị trí của hub trong nhãn [first, last), -1 nếu không có
+    static long long findHub(const std::uint32_t* hubs, std::uint64_t first, std::uint64_t last, std::uint32_t hub);
+
+public:
+    HubLabels();
+
+    // false nếu đồ thị rỗng hoặc có trọng số âm. withPaths = false bỏ mảng parents (nhỏ hơn 1/3)
+    bool build(const Graph& graph, bool withPaths = true);
+
+    // File đặt cạnh file đồ thị (xem pathFor). open() ánh xạ file, không sao chép;
+    // trả về false nếu file không hợp lệ hoặc được dựng cho đồ thị khác
+    bool save(const std::string& filename) const;
+    bool open(const std::string& filename, const CsrGraph& csr);
+    static std::string pathFor(const std::string& graphFile) { return graphFile + ".hub"; }
+
+    bool isBuilt() const { return header != nullptr; }
+    bool hasPaths() const { return outParents != nullptr; }
+    int getVertexCount() const { return V; }
+    // Tổng số mục nhãn cả hai chiều, không tính sentinel
+    long long getEntryCount() const;
+    double averageLabelSize() const;
+    long long memoryUsageBytes() const;
+
+    // Chỉ khoảng cách: một lượt trộn hai nhãn đã sắp xếp. -1 nếu không tới được
+    int distance(int source, int target) const;
+    // Khoảng cách và (nếu hasPaths) đường đi; settledVertices = số mục nhãn đã duyệt
+    PointToPointResult query(int source, int target) const;
+};
+
+#endif
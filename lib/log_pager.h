@@ -0,0 +1,70 @@
+#ifndef LOG_PAGER_H
+#define LOG_PAGER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "log_source.h"
+
+// Phân trang ảo cho một LogSource: không ngắt dòng trước toàn bộ log. Chỉ mục trang chỉ lưu
+// vị trí bắt đầu của mỗi trang (dòng gốc, phần thứ mấy sau khi ngắt), được mở rộng dần khi
+// người xem đi tới; lấy một trang đã có trong chỉ mục (kể cả lùi lại) chỉ đọc và ngắt đúng các
+// dòng của trang đó. Tới trang chưa có trong chỉ mục thì phải đi qua các trang ở giữa một lần.
+class LogPager {
+public:
+    using WrapFunction = std::function<std::vector<std::string>(const std::string&)>;
+
+    struct Line {
+        int color;
+        std::string text;
+        size_t sourceLine;      // chỉ số dòng gốc trong LogSource
+    };
+
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+private:
+    struct Anchor {
+        size_t line;
+        size_t part;
+    };
+
+    const LogSource& source;
+    size_t linesPerPage;
+    WrapFunction wrap;
+    size_t totalLines;
+    std::vector<Anchor> starts;         // starts[p] = vị trí đầu trang p
+    bool complete;                      // chỉ mục đã tới cuối log
+    // Khối dòng gốc đọc gần nhất: lập chỉ mục tuần tự không phải hỏi source theo từng trang
+    mutable std::vector<std::pair<int, std::string>> block;
+    mutable size_t blockFirst;
+
+    // Dòng gốc line (line < totalLines), nullptr nếu source trả về ít dòng hơn lineCount()
+    const std::pair<int, std::string>* fetch(size_t line) const;
+
+    // Đi qua một trang bắt đầu tại from (ghi các dòng vào out nếu khác nullptr), trả về vị trí đầu trang sau
+    Anchor walk(Anchor from, std::vector<Line>* out) const;
+    void record(size_t index, Anchor next);
+    void extendTo(size_t index);
+
+public:
+    LogPager(const LogSource& logs, size_t pageLines, WrapFunction wrapLine);
+
+    // Các dòng đã ngắt của trang index (từ 0); false nếu log có ít trang hơn
+    bool page(size_t index, std::vector<Line>& out);
+    bool isLastPage(size_t index);
+    // Số trang đã biết; bằng tổng số trang khi isComplete()
+    size_t indexedPages() const { return starts.size(); }
+    bool isComplete() const { return complete; }
+    // Lập chỉ mục tới cuối log (đi qua mọi trang chưa biết)
+    size_t pageCount();
+
+    size_t lineCount() const { return totalLines; }
+    size_t firstLineOf(size_t index) const { return starts[index].line; }
+    // Trang chứa phần đầu của dòng gốc line
+    size_t pageOfLine(size_t line);
+    // Dòng gốc đầu tiên từ fromLine trở đi có chứa text, NOT_FOUND nếu không có
+    size_t find(const std::string& text, size_t fromLine) const;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef LOG_SOURCE_H
+#define LOG_SOURCE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Nguồn dòng log (mã màu, nội dung) cho GUI::showAlgorithmLogs. Màn hình chỉ hỏi các dòng
+// của trang đang xem, nên nguồn có thể dựng chữ theo yêu cầu thay vì giữ sẵn mọi dòng.
+class LogSource {
+public:
+    virtual ~LogSource() = default;
+
+    virtual size_t lineCount() const = 0;
+    // Thêm các dòng [first, first + count) (cắt ở cuối nguồn) vào out
+    virtual void lines(size_t first, size_t count, std::vector<std::pair<int, std::string>>& out) const = 0;
+};
+
+// Bọc một vector dòng có sẵn (PathResult::logs), không sao chép
+class VectorLogSource : public LogSource {
+private:
+    const std::vector<std::pair<int, std::string>>& logs;
+
+public:
+    explicit VectorLogSource(const std::vector<std::pair<int, std::string>>& source) : logs(source) {}
+
+    size_t lineCount() const override { return logs.size(); }
+    void lines(size_t first, size_t count, std::vector<std::pair<int, std::string>>& out) const override {
+        for (size_t i = first; i < logs.size() && i < first + count; i++) {
+            out.push_back(logs[i]);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstdint>
+#include <string>
+
+// Ánh xạ một file chỉ đọc vào bộ nhớ (mmap trên POSIX, file mapping trên Windows)
+class MappedFile {
+private:
+    const char* bytes;
+    std::uint64_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mapHandle;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // File rỗng không ánh xạ được và trả về false
+    bool open(const std::string& filename);
+    void close();
+
+    const char* data() const { return bytes; }
+    std::uint64_t size() const { return length; }
+};
+
+#endif
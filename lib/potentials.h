@@ -0,0 +1,26 @@
+#ifndef POTENTIALS_H
+#define POTENTIALS_H
+
+#include <vector>
+
+class CsrGraph;
+
+// Thế năng Johnson: h(v) = khoảng cách từ một đỉnh ảo có cạnh trọng số 0 tới mọi đỉnh.
+// Với mọi cạnh u -> v: h(v) <= h(u) + w nên trọng số rút gọn w + h(u) - h(v) >= 0 và
+// Dijkstra chạy được trên đó; d(s, t) = d'(s, t) - h(s) + h(t). Đường ngắn nhất giữ nguyên.
+// Graph::getPotentials() tính một lần rồi giữ lại cho tới khi đồ thị bị sửa.
+struct VertexPotentials {
+    bool hasNegativeCycle;
+    bool outOfRange;            // |h| quá lớn để khoảng cách rút gọn còn nằm trong int
+    int passes;                 // số lượt Bellman-Ford đã chạy
+    std::vector<int> values;    // h(v) <= 0; rỗng nếu không dùng được
+
+    VertexPotentials() : hasNegativeCycle(false), outOfRange(false), passes(0) {}
+
+    bool isUsable() const { return !hasNegativeCycle && !outOfRange; }
+};
+
+// Bellman-Ford từ đỉnh ảo (tức h = 0 ở mọi đỉnh lúc đầu), dừng ngay khi một lượt không cập nhật
+VertexPotentials computePotentials(const CsrGraph& csr);
+
+#endif
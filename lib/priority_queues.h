@@ -0,0 +1,279 @@
+#ifndef PRIORITY_QUEUES_H
+#define PRIORITY_QUEUES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Các hàng đợi ưu tiên dùng cho Dijkstra, chung một giao diện:
+//   Queue(int vertexCount)
+//   bool empty() const
+//   void push(int key, int vertex)      // thêm mới hoặc giảm khóa
+//   std::pair<int, int> pop()           // lấy (khóa, đỉnh) nhỏ nhất
+// Hàng đợi "lazy" có thể trả lại một đỉnh nhiều lần; Dijkstra bỏ qua bản cũ bằng visited.
+
+// Heap nhị phân của std::priority_queue với xóa lười (cách làm ban đầu), O(E) phần tử
+class BinaryHeapQueue {
+private:
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> heap;
+
+public:
+    explicit BinaryHeapQueue(int vertexCount) { (void)vertexCount; }
+
+    bool empty() const { return heap.empty(); }
+    void push(int key, int vertex) { heap.push({key, vertex}); }
+
+    std::pair<int, int> pop() {
+        auto top = heap.top();
+        heap.pop();
+        return top;
+    }
+};
+
+// BinaryHeapQueue trên vector của người gọi (QueryWorkspace::queue()): cùng thứ tự lấy ra,
+// nhưng dung lượng được giữ lại giữa các truy vấn nên không cấp phát lại
+class BorrowedHeapQueue {
+private:
+    std::vector<std::pair<int, int>>& heap;
+
+public:
+    explicit BorrowedHeapQueue(std::vector<std::pair<int, int>>& storage) : heap(storage) { heap.clear(); }
+
+    bool empty() const { return heap.empty(); }
+    void push(int key, int vertex) {
+        heap.push_back({key, vertex});
+        std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<int, int>>());
+    }
+
+    std::pair<int, int> pop() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<int, int>>());
+        auto top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+};
+
+// Heap d-phân có chỉ mục: mỗi đỉnh xuất hiện tối đa một lần, giảm khóa thật sự, bộ nhớ O(V)
+template <int D = 4>
+class IndexedDaryHeap {
+    static_assert(D >= 2, "IndexedDaryHeap needs D >= 2");
+
+private:
+    std::vector<std::pair<int, int>> heap;  // (khóa, đỉnh)
+    std::vector<int> position;              // vị trí của đỉnh trong heap, -1 nếu không có
+
+    void place(int index, const std::pair<int, int>& item) {
+        heap[index] = item;
+        position[item.second] = index;
+    }
+
+    void siftUp(int index) {
+        auto item = heap[index];
+        while (index > 0) {
+            int parent = (index - 1) / D;
+            if (!(item.first < heap[parent].first)) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, item);
+    }
+
+    void siftDown(int index) {
+        auto item = heap[index];
+        const int size = static_cast<int>(heap.size());
+        while (true) {
+            int first = index * D + 1;
+            if (first >= size) break;
+            int last = first + D < size ? first + D : size;
+            int best = first;
+            for (int c = first + 1; c < last; c++) {
+                if (heap[c].first < heap[best].first) best = c;
+            }
+            if (!(heap[best].first < item.first)) break;
+            place(index, heap[best]);
+            index = best;
+        }
+        place(index, item);
+    }
+
+public:
+    explicit IndexedDaryHeap(int vertexCount) : position(vertexCount, -1) {}
+
+    bool empty() const { return heap.empty(); }
+    // Khóa nhỏ nhất hiện có (heap không rỗng), dùng cho điều kiện dừng của tìm kiếm hai chiều
+    int minKey() const { return heap.front().first; }
+
+    void push(int key, int vertex) {
+        int index = position[vertex];
+        if (index < 0) {
+            heap.push_back({key, vertex});
+            siftUp(static_cast<int>(heap.size()) - 1);
+        } else if (key < heap[index].first) {
+            heap[index].first = key;
+            siftUp(index);
+        }
+    }
+
+    std::pair<int, int> pop() {
+        auto top = heap.front();
+        position[top.second] = -1;
+        auto last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return top;
+    }
+};
+
+// Pairing heap với nút cấp phát sẵn theo đỉnh; giảm khóa bằng cắt cây con rồi ghép lại
+class PairingHeap {
+private:
+    struct Node {
+        int key = 0;
+        int child = -1;
+        int sibling = -1;
+        int prev = -1;      // nút cha nếu là con đầu, ngược lại là anh liền trước
+        bool inHeap = false;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> pairs;  // bộ đệm cho lượt ghép hai chiều
+    int root;
+
+    int meld(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (nodes[b].key < nodes[a].key) std::swap(a, b);
+        // b thành con đầu của a
+        nodes[b].prev = a;
+        nodes[b].sibling = nodes[a].child;
+        if (nodes[a].child >= 0) nodes[nodes[a].child].prev = b;
+        nodes[a].child = b;
+        nodes[a].sibling = -1;
+        nodes[a].prev = -1;
+        return a;
+    }
+
+    void detach(int x) {
+        int p = nodes[x].prev;
+        if (nodes[p].child == x) {
+            nodes[p].child = nodes[x].sibling;
+        } else {
+            nodes[p].sibling = nodes[x].sibling;
+        }
+        if (nodes[x].sibling >= 0) nodes[nodes[x].sibling].prev = p;
+        nodes[x].sibling = -1;
+        nodes[x].prev = -1;
+    }
+
+    int mergePairs(int first) {
+        pairs.clear();
+        while (first >= 0) {
+            int a = first;
+            int b = nodes[a].sibling;
+            first = b >= 0 ? nodes[b].sibling : -1;
+            nodes[a].sibling = nodes[a].prev = -1;
+            if (b >= 0) nodes[b].sibling = nodes[b].prev = -1;
+            pairs.push_back(meld(a, b));
+        }
+        int result = -1;
+        for (int i = static_cast<int>(pairs.size()) - 1; i >= 0; i--) {
+            result = meld(pairs[i], result);
+        }
+        return result;
+    }
+
+public:
+    explicit PairingHeap(int vertexCount) : nodes(vertexCount), root(-1) {}
+
+    bool empty() const { return root < 0; }
+
+    void push(int key, int vertex) {
+        Node& node = nodes[vertex];
+        if (!node.inHeap) {
+            node = Node();
+            node.key = key;
+            node.inHeap = true;
+            root = meld(root, vertex);
+        } else if (key < node.key) {
+            node.key = key;
+            if (vertex != root) {
+                detach(vertex);
+                root = meld(root, vertex);
+            }
+        }
+    }
+
+    std::pair<int, int> pop() {
+        int top = root;
+        nodes[top].inHeap = false;
+        root = mergePairs(nodes[top].child);
+        nodes[top].child = -1;
+        return {nodes[top].key, top};
+    }
+};
+
+// Radix heap cho khóa nguyên không âm và đơn điệu (khóa push luôn >= khóa pop gần nhất),
+// đúng với Dijkstra khi trọng số không âm. Bucket i chứa khóa khác `last` ở bit cao nhất
+// thứ i, nên mỗi phần tử chỉ bị chuyển bucket O(log C) lần. Xóa lười như BinaryHeapQueue.
+class RadixHeap {
+private:
+    static const int BUCKETS = 33;
+    std::vector<std::pair<std::uint32_t, int>> buckets[BUCKETS];
+    std::uint32_t last;
+    std::size_t count;
+
+    static int bucketOf(std::uint32_t key, std::uint32_t base) {
+        std::uint32_t diff = key ^ base;
+        if (diff == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return 32 - __builtin_clz(diff);
+#else
+        int width = 0;
+        while (diff) {
+            diff >>= 1;
+            width++;
+        }
+        return width;
+#endif
+    }
+
+public:
+    explicit RadixHeap(int vertexCount) : last(0), count(0) { (void)vertexCount; }
+
+    bool empty() const { return count == 0; }
+
+    void push(int key, int vertex) {
+        std::uint32_t k = static_cast<std::uint32_t>(key);
+        buckets[bucketOf(k, last)].push_back({k, vertex});
+        count++;
+    }
+
+    std::pair<int, int> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            std::uint32_t newLast = buckets[i][0].first;
+            for (const auto& item : buckets[i]) {
+                if (item.first < newLast) newLast = item.first;
+            }
+            last = newLast;
+            for (const auto& item : buckets[i]) {
+                buckets[bucketOf(item.first, last)].push_back(item);
+            }
+            buckets[i].clear();
+        }
+        auto item = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return {static_cast<int>(item.first), item.second};
+    }
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef QUERY_WORKSPACE_H
+#define QUERY_WORKSPACE_H
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Bộ nhớ làm việc dùng lại giữa các truy vấn (Algorithms::dijkstra/bellmanFord bản có workspace).
+// Mỗi đỉnh mang số thế hệ (generation) của lần cuối được chạm tới: begin() chỉ tăng số thế hệ nên
+// nhãn cũ tự hết hiệu lực, không phải gán lại INF cho cả V đỉnh. touched liệt kê các đỉnh truy vấn
+// hiện tại đã chạm, là toàn bộ phần kết quả có ý nghĩa.
+// Không an toàn khi dùng chung giữa các luồng: mỗi luồng giữ một workspace riêng.
+class QueryWorkspace {
+private:
+    std::vector<int> dist;
+    std::vector<int> parent;
+    std::vector<std::uint32_t> reached;     // reached[v] == generation: dist/parent của v hợp lệ
+    std::vector<std::uint32_t> settled;     // settled[v] == generation: v đã được chốt
+    std::uint32_t generation;
+    std::vector<int> touched;
+    std::vector<std::pair<int, int>> heap;  // hàng đợi (khoảng cách, đỉnh) của Dijkstra, giữ dung lượng
+
+public:
+    static constexpr int INF = std::numeric_limits<int>::max();
+
+    explicit QueryWorkspace(int vertexCount = 0);
+
+    // Bắt đầu truy vấn mới trên đồ thị vertexCount đỉnh: O(1), trừ khi số đỉnh đổi
+    // hoặc số thế hệ quay vòng (khi đó mới xóa toàn bộ)
+    void begin(int vertexCount);
+
+    int getVertexCount() const { return static_cast<int>(dist.size()); }
+    bool isReached(int v) const { return reached[v] == generation; }
+    bool isSettled(int v) const { return settled[v] == generation; }
+    int distance(int v) const { return isReached(v) ? dist[v] : INF; }
+    int previous(int v) const { return isReached(v) ? parent[v] : -1; }
+    const std::vector<int>& touchedVertices() const { return touched; }
+    // Đường start -> target theo previous; rỗng nếu target chưa được chạm tới
+    std::vector<int> path(int target) const;
+
+    // Dành cho engine
+    void reach(int v, int d, int p) {
+        if (reached[v] != generation) {
+            reached[v] = generation;
+            touched.push_back(v);
+        }
+        dist[v] = d;
+        parent[v] = p;
+    }
+    // false nếu v đã được chốt trong truy vấn này
+    bool settle(int v) {
+        if (settled[v] == generation) return false;
+        settled[v] = generation;
+        return true;
+    }
+    std::vector<std::pair<int, int>>& queue() { return heap; }
+
+    long long memoryUsageBytes() const;
+};
+
+#endif
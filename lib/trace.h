@@ -0,0 +1,65 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Global.h"
+#include "Graph.h"
+
+// Nơi nhận sự kiện khi engine chạy có theo dõi (Algorithms::dijkstra/bellmanFord bản TraceSink).
+// Sự kiện chỉ mang chỉ số đỉnh và số nguyên; việc đổi ra chữ là của từng sink.
+// Bản không theo dõi được biên dịch riêng và không gọi tới đây (xem algorithms.cpp).
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+
+    // engine: DIJKSTRA hoặc BELLMAN_FORD
+    virtual void begin(AlgorithmType engine, int start) { (void)engine; (void)start; }
+    // Bellman-Ford: bắt đầu lượt round (từ 1) trên tổng totalRounds lượt
+    virtual void beginRound(int round, int totalRounds) { (void)round; (void)totalRounds; }
+    // Dijkstra: lần lặp round chốt vertex với khoảng cách distance
+    virtual void settle(int round, int vertex, int distance) { (void)round; (void)vertex; (void)distance; }
+    virtual void relax(int from, int to, int distance) { (void)from; (void)to; (void)distance; }
+    virtual void endRound(int round, bool updated, const std::vector<int>& distances) {
+        (void)round; (void)updated; (void)distances;
+    }
+    virtual void beginCycleCheck() {}
+    virtual void negativeCycleEdge(int from, int to, int weight) { (void)from; (void)to; (void)weight; }
+    virtual void finish(const std::vector<int>& distances, bool hasNegativeCycle) {
+        (void)distances; (void)hasNegativeCycle;
+    }
+    // Johnson: trước khi chạy Dijkstra trên trọng số rút gọn / sau khi đổi về khoảng cách gốc
+    virtual void reweighted(int bellmanFordPasses) { (void)bellmanFordPasses; }
+    virtual void restored(const std::vector<int>& distances) { (void)distances; }
+};
+
+// Log từng bước bằng chữ như màn hình "QUÁ TRÌNH THỰC HIỆN THUẬT TOÁN" (mã màu, nội dung)
+class StepLogSink : public TraceSink {
+private:
+    const Graph& graph;
+    std::vector<std::pair<int, std::string>>& logs;
+    AlgorithmType engine;
+
+    void log(int color, const std::string& message) { logs.push_back({color, message}); }
+    void logTable(const std::vector<int>& distances);
+
+public:
+    StepLogSink(const Graph& g, std::vector<std::pair<int, std::string>>& output);
+
+    // Tiếp tục dựng chữ từ giữa luồng sự kiện (EventTrace) mà không có begin() tương ứng
+    void resume(AlgorithmType type) { engine = type; }
+
+    void begin(AlgorithmType type, int start) override;
+    void beginRound(int round, int totalRounds) override;
+    void settle(int round, int vertex, int distance) override;
+    void relax(int from, int to, int distance) override;
+    void endRound(int round, bool updated, const std::vector<int>& distances) override;
+    void beginCycleCheck() override;
+    void negativeCycleEdge(int from, int to, int weight) override;
+    void finish(const std::vector<int>& distances, bool hasNegativeCycle) override;
+    void reweighted(int bellmanFordPasses) override;
+    void restored(const std::vector<int>& distances) override;
+};
+
+#endif
@@ -1,6 +1,8 @@
 #include "../lib/GUI.h"
+#include "../lib/log_pager.h"
 #include <iostream>
 #include <cctype>
+#include <climits>
 #include <sstream>
 
 namespace {
@@ -748,7 +750,9 @@ void GUI::showGraphSummary(int numVertices, int numEdges, const std::vector<std:
         lines.push_back({10, "Danh sách cạnh:"});
         int displayCount = (int)edges.size();
         int maxDisplayEdges = 10;
-        if (displayCount <= maxDisplayEdges + 2) {
+        // edges có thể chỉ gồm 5 cạnh đầu và 5 cạnh cuối của numEdges cạnh: vẫn in "..." ở giữa
+        bool excerpt = displayCount == maxDisplayEdges && numEdges > displayCount;
+        if (displayCount <= maxDisplayEdges + 2 && !excerpt) {
             for (int i = 0; i < displayCount; ++i) {
                 int u = std::get<0>(edges[i]) + 1;
                 int v = std::get<1>(edges[i]) + 1;
@@ -777,10 +781,12 @@ void GUI::showGraphSummary(int numVertices, int numEdges, const std::vector<std:
 }
 
 void GUI::showAlgorithmLogs(const std::string& title, const std::vector<std::pair<int, std::string>>& logs) {
-    size_t index = 0;
+    showAlgorithmLogs(title, VectorLogSource(logs));
+}
+
+void GUI::showAlgorithmLogs(const std::string& title, const LogSource& source) {
     int lineH = approxLineHeight();
     int lineStep = lineH;
-    std::vector<std::pair<int, std::string>> wrappedLogs;
     const int margin = 1;
     const int left = margin;
     const int right = WINDOW_WIDTH - margin;
@@ -796,15 +802,6 @@ void GUI::showAlgorithmLogs(const std::string& title, const std::vector<std::pai
     int innerTopBase = top + 2 * lineH;
 
     int maxWidth = right - innerLeftBase - 2;
-    for (const auto& log : logs) {
-        auto parts = wrapLineToWidth(log.second, maxWidth);
-        for (const auto& p : parts) {
-            wrappedLogs.push_back({log.first, p});
-        }
-    }
-    if (wrappedLogs.empty()) {
-        wrappedLogs.push_back({COLOR_TEXT, ""});
-    }
 
     int usableBottom = bottom - lineH;
     int maxLinesPerPage = (usableBottom - innerTopBase) / lineStep + 1;
@@ -813,18 +810,59 @@ void GUI::showAlgorithmLogs(const std::string& title, const std::vector<std::pai
     if (maxLinesPerPage > safetyLines) {
         maxLinesPerPage -= safetyLines;
     }
-    int totalPages = static_cast<int>((wrappedLogs.size() + maxLinesPerPage - 1) / maxLinesPerPage);
-    if (totalPages < 1) totalPages = 1;
+    const int footerY = bottom - 2 * lineH;
+    const int markerX = innerLeftBase - 2 * approxCharWidth();
+
+    // Chỉ ngắt dòng các trang được xem; chỉ mục trang mở rộng dần (log_pager.h)
+    LogPager pager(source, static_cast<size_t>(maxLinesPerPage),
+                   [maxWidth](const std::string& line) { return wrapLineToWidth(line, maxWidth); });
+
+    std::vector<LogPager::Line> pageLines;
+    size_t page = 0;
+    size_t match = LogPager::NOT_FOUND;
+    std::string query;
+    std::string status;
+
+    // Hỏi một dòng nhập ở chân trang, trên trang đang hiển thị
+    auto promptFooter = [&](const std::string& prompt, InputFilter filter) {
+        setcolor(COLOR_TEXT);
+        clearTextLine(innerLeftBase, footerY, (right - innerLeftBase) / approxCharWidth() - 1);
+        drawLeftAlignedText(innerLeftBase, footerY, prompt);
+        return trim(readLineAt(innerLeftBase + approxTextWidth(prompt), footerY, 30, filter));
+    };
+    auto search = [&](size_t fromLine) {
+        size_t found = pager.find(query, fromLine);
+        if (found == LogPager::NOT_FOUND && fromLine > 0) {
+            found = pager.find(query, 0);
+            if (found != LogPager::NOT_FOUND) status = "Đã tìm lại từ đầu log.";
+        }
+        if (found == LogPager::NOT_FOUND) {
+            status = "Không tìm thấy \"" + query + "\".";
+            return;
+        }
+        match = found;
+        page = pager.pageOfLine(found);
+    };
+
+    while (true) {
+        if (!pager.page(page, pageLines)) {
+            page = pager.indexedPages() - 1;
+            pager.page(page, pageLines);
+        }
+        bool lastPage = pager.isLastPage(page);
 
-    int page = 0;
-    while (index < wrappedLogs.size()) {
-        page++;
         clearScreen();
         setbkcolor(COLOR_BACKGROUND);
 
         std::string pageTitle = title;
-        if (totalPages > 1) {
-            pageTitle += " (Trang " + std::to_string(page) + "/" + std::to_string(totalPages) + ")";
+        if (page > 0 || !lastPage) {
+            if (pager.isComplete()) {
+                pageTitle += " (Trang " + std::to_string(page + 1) + "/" + std::to_string(pager.indexedPages()) + ")";
+            } else {
+                pageTitle += " (Trang " + std::to_string(page + 1) + ", dòng " +
+                             std::to_string(pager.firstLineOf(page) + 1) + "/" +
+                             std::to_string(pager.lineCount()) + ")";
+            }
         }
 
         int centerX = 0;
@@ -835,16 +873,64 @@ void GUI::showAlgorithmLogs(const std::string& title, const std::vector<std::pai
         innerTop = innerTopBase;
 
         int yPos = innerTop;
-        int count = 0;
-        while (index < wrappedLogs.size() && count < maxLinesPerPage) {
-            setcolor(wrappedLogs[index].first);
-            outtextxy(innerLeft, yPos, (char*)wrappedLogs[index].second.c_str());
+        for (const auto& line : pageLines) {
+            if (line.sourceLine == match) {
+                setcolor(YELLOW);
+                drawLeftAlignedText(markerX, yPos, ">>");
+            }
+            setcolor(line.color);
+            outtextxy(innerLeft, yPos, (char*)line.text.c_str());
             yPos += lineStep;
-            index++;
-            count++;
         }
 
-        getch();
+        setcolor(LIGHTCYAN);
+        if (!status.empty()) {
+            drawLeftAlignedText(innerLeftBase, footerY, status);
+            status.clear();
+        } else {
+            drawLeftAlignedText(innerLeftBase, footerY,
+                                "<- -> PgUp PgDn Home End: lật trang  G: tới trang  /: tìm  N: tìm tiếp  Esc: thoát");
+        }
+
+        int c = getch();
+        if (c == 0 || c == 224) {
+            // Phím mở rộng: mã quét ở lần getch() thứ hai
+            int key = getch();
+            if (key == 75 || key == 72 || key == 73) {            // trái, lên, PgUp
+                if (page > 0) page--;
+            } else if (key == 77 || key == 80 || key == 81) {     // phải, xuống, PgDn
+                if (!lastPage) page++;
+            } else if (key == 71) {                               // Home
+                page = 0;
+            } else if (key == 79) {                               // End
+                page = pager.pageCount() - 1;
+            }
+        } else if (c == 27 || c == 'q' || c == 'Q') {
+            return;
+        } else if (c == 8 || c == 127 || c == 'b' || c == 'B') {   // Backspace (127 trên terminal Unix)
+            if (page > 0) page--;
+        } else if (c == 'g' || c == 'G') {
+            int target = 0;
+            if (tryParseInt(promptFooter("Tới trang: ", InputFilter::Integer), target) && target >= 1) {
+                page = static_cast<size_t>(target - 1);
+            }
+        } else if (c == '/') {
+            std::string text = promptFooter("Tìm: ", InputFilter::Any);
+            if (!text.empty()) {
+                query = text;
+                search(pager.firstLineOf(page));
+            }
+        } else if (c == 'n' || c == 'N') {
+            if (query.empty()) {
+                status = "Chưa có chuỗi tìm kiếm (nhấn /).";
+            } else {
+                search(match == LogPager::NOT_FOUND ? pager.firstLineOf(page) : match + 1);
+            }
+        } else {
+            // Phím khác: sang trang sau như trước, hết log thì đóng
+            if (lastPage) return;
+            page++;
+        }
     }
 }
 
@@ -1,43 +1,257 @@
 #include "../lib/Algorithms.h"
+#include "../lib/csr_graph.h"
+#include "../lib/potentials.h"
+#include "../lib/priority_queues.h"
+#include "../lib/query_workspace.h"
+#include "../lib/trace.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
 #include <queue>
 #include <limits>
-#include <sstream>
-#include <iomanip>
+#include <unordered_map>
 
 namespace {
-std::vector<std::pair<int, std::string>> formatDistanceTable(const Graph& graph, const std::vector<int>& distances) {
-    std::vector<std::pair<int, std::string>> lines;
-    if (distances.empty()) return lines;
+// Hai cách duyệt cạnh ra của một đỉnh: danh sách kề gốc và ảnh chụp CSR.
+struct AdjacencyListView {
+    const std::vector<std::vector<Edge>>& adjList;
 
-    const int INF = std::numeric_limits<int>::max();
-    std::ostringstream header;
-    std::ostringstream values;
+    int vertexCount() const { return static_cast<int>(adjList.size()); }
 
-    header << "Đỉnh :";
-    values << "D(i) :";
+    template <typename Visit>
+    void forEachEdge(int u, Visit&& visit) const {
+        for (const auto& edge : adjList[u]) {
+            visit(edge.destination, edge.weight);
+        }
+    }
+};
 
-    for (size_t i = 0; i < distances.size(); ++i) {
-        const std::string label = graph.getVertexLabel(static_cast<int>(i));
-        header << std::setw(6) << label;
-        if (distances[i] == INF) {
-            values << std::setw(6) << "INF";
-        } else {
-            values << std::setw(6) << distances[i];
+struct CsrView {
+    const int* offsets;
+    const int* targets;
+    const int* weights;
+    int V;
+
+    explicit CsrView(const CsrGraph& csr)
+        : offsets(csr.getOffsets()), targets(csr.getTargets()),
+          weights(csr.getWeights()), V(csr.getVertexCount()) {}
+
+    int vertexCount() const { return V; }
+
+    template <typename Visit>
+    void forEachEdge(int u, Visit&& visit) const {
+        const int end = offsets[u + 1];
+        for (int i = offsets[u]; i < end; i++) {
+            visit(targets[i], weights[i]);
         }
     }
+};
+// Đồ thị đọc từ file nhị phân chạy thẳng trên CSR đã mmap, không dựng danh sách kề;
+// đồ thị thường vẫn duyệt adjList như trước
+template <typename Run>
+auto withGraphAdjacency(const Graph& graph, Run&& run) {
+    if (graph.isFileBacked()) {
+        return run(CsrView(graph.getCsr()));
+    }
+    return run(AdjacencyListView{graph.getAdjacencyList()});
+}
+
+// Trọng số rút gọn theo thế năng: w + h(u) - h(v), luôn >= 0 nếu h là thế năng hợp lệ
+template <typename Inner>
+struct ReducedCostView {
+    const Inner& inner;
+    const int* potential;
 
-    lines.push_back({15, header.str()});
-    lines.push_back({14, values.str()});
-    return lines;
+    int vertexCount() const { return inner.vertexCount(); }
+
+    template <typename Visit>
+    void forEachEdge(int u, Visit&& visit) const {
+        const int hu = potential[u];
+        inner.forEachEdge(u, [&](int v, int weight) {
+            visit(v, weight + hu - potential[v]);
+        });
+    }
+};
+
+// Chính sách theo dõi cho engine: NoTrace không có trạng thái và mọi lời gọi nằm sau
+// `if constexpr (Trace::enabled)`, nên bản không theo dõi là vòng lặp trơn không có mã log.
+struct NoTrace {
+    static constexpr bool enabled = false;
+};
+
+struct SinkTrace {
+    static constexpr bool enabled = true;
+    TraceSink& sink;
+};
+
+// showSteps = true: chạy bản có theo dõi, ghi log chữ vào result.logs như trước
+template <typename Run>
+PathResult runWithSteps(const Graph& graph, bool showSteps, Run&& run) {
+    if (!showSteps) {
+        NoTrace trace;
+        return run(trace);
+    }
+    std::vector<std::pair<int, std::string>> logs;
+    StepLogSink sink(graph, logs);
+    SinkTrace trace{sink};
+    PathResult result = run(trace);
+    result.logs = std::move(logs);
+    return result;
 }
-} // namespace
 
-Algorithms::Algorithms(const Graph& g) : graph(g) {}
+// Nơi engine ghi khoảng cách/đỉnh trước. DenseLabels là hai mảng V phần tử của PathResult
+// (khởi tạo O(V)); WorkspaceLabels ghi vào QueryWorkspace (khởi tạo O(1), chỉ duyệt đỉnh đã chạm).
+// Dijkstra và Bellman-Ford dùng chung một vòng lặp cho cả hai loại.
+class DenseLabels {
+private:
+    PathResult& result;
+    std::vector<bool> done;
+
+public:
+    DenseLabels(PathResult& r, int V) : result(r), done(V, false) {
+        result.distances.assign(V, std::numeric_limits<int>::max());
+        result.previousVertex.assign(V, -1);
+    }
+
+    int distance(int v) const { return result.distances[v]; }
+    void reach(int v, int d, int p) {
+        result.distances[v] = d;
+        result.previousVertex[v] = p;
+    }
+    bool settle(int v) {
+        if (done[v]) return false;
+        done[v] = true;
+        return true;
+    }
+    template <typename Visit>
+    void forEachSource(Visit visit) const {
+        const int V = static_cast<int>(result.distances.size());
+        for (int u = 0; u < V; u++) visit(u);
+    }
+    const std::vector<int>& distances() const { return result.distances; }
+};
+
+class WorkspaceLabels {
+private:
+    QueryWorkspace& workspace;
+
+public:
+    explicit WorkspaceLabels(QueryWorkspace& w) : workspace(w) {}
+
+    int distance(int v) const { return workspace.distance(v); }
+    void reach(int v, int d, int p) { workspace.reach(v, d, p); }
+    bool settle(int v) { return workspace.settle(v); }
+    // đỉnh chưa chạm tới có khoảng cách INF nên cạnh ra của nó không bao giờ nới được;
+    // danh sách touched lớn dần trong lượt nên đỉnh mới chạm cũng được xét ngay
+    template <typename Visit>
+    void forEachSource(Visit visit) const {
+        const auto& touched = workspace.touchedVertices();
+        for (size_t i = 0; i < touched.size(); i++) visit(touched[i]);
+    }
+};
+
+// target >= 0: dừng khi target được chốt. Trả về số đỉnh đã chốt
+template <typename Trace, typename Adjacency, typename Labels, typename Queue>
+int dijkstraLoop(const Adjacency& adj, int start, Trace& trace, Labels& labels, Queue& pq, int target) {
+    const int INF = std::numeric_limits<int>::max();
+    labels.reach(start, 0, -1);
+    pq.push(0, start);
+
+    if constexpr (Trace::enabled) trace.sink.begin(AlgorithmType::DIJKSTRA, start);
 
-void Algorithms::logStep(std::vector<std::pair<int, std::string>>& logs, int color, const std::string& message) {
-    logs.push_back({color, message});
+    int iterations = 0;
+
+    while (!pq.empty()) {
+        auto [dist, u] = pq.pop();
+
+        if (!labels.settle(u)) continue;
+        iterations++;
+
+        if constexpr (Trace::enabled) trace.sink.settle(iterations, u, dist);
+        if (u == target) break;
+
+        adj.forEachEdge(u, [&](int v, int weight) {
+            if (labels.distance(u) != INF && 
+                labels.distance(u) + weight < labels.distance(v)) {
+                
+                labels.reach(v, labels.distance(u) + weight, u);
+                pq.push(labels.distance(v), v);
+
+                if constexpr (Trace::enabled) trace.sink.relax(u, v, labels.distance(v));
+            }
+        });
+
+        if constexpr (Trace::enabled) trace.sink.endRound(iterations, true, labels.distances());
+    }
+
+    if constexpr (Trace::enabled) trace.sink.finish(labels.distances(), false);
+    return iterations;
 }
 
+// V - 1 lượt nới rồi một lượt kiểm tra; stopWhenStable = true thì dừng ngay khi một lượt
+// không cập nhật gì. Trả về true nếu có chu trình âm tới được từ start
+template <typename Trace, typename Adjacency, typename Labels>
+bool bellmanFordLoop(const Adjacency& adj, int start, Trace& trace, Labels& labels, bool stopWhenStable) {
+    const int INF = std::numeric_limits<int>::max();
+    const int V = adj.vertexCount();
+    labels.reach(start, 0, -1);
+
+    if constexpr (Trace::enabled) trace.sink.begin(AlgorithmType::BELLMAN_FORD, start);
+
+    for (int i = 0; i < V - 1; i++) {
+        bool updated = false;
+
+        if constexpr (Trace::enabled) trace.sink.beginRound(i + 1, V - 1);
+
+        labels.forEachSource([&](int u) {
+            adj.forEachEdge(u, [&](int v, int weight) {
+                if (labels.distance(u) != INF && 
+                    labels.distance(u) + weight < labels.distance(v)) {
+                    
+                    labels.reach(v, labels.distance(u) + weight, u);
+                    updated = true;
+
+                    if constexpr (Trace::enabled) trace.sink.relax(u, v, labels.distance(v));
+                }
+            });
+        });
+
+        if constexpr (Trace::enabled) trace.sink.endRound(i + 1, updated, labels.distances());
+        if (!updated && stopWhenStable) break;
+    }
+
+    bool negativeCycle = false;
+    if constexpr (Trace::enabled) trace.sink.beginCycleCheck();
+
+    labels.forEachSource([&](int u) {
+        adj.forEachEdge(u, [&](int v, int weight) {
+            if (labels.distance(u) != INF && 
+                labels.distance(u) + weight < labels.distance(v)) {
+                negativeCycle = true;
+
+                if constexpr (Trace::enabled) trace.sink.negativeCycleEdge(u, v, weight);
+            }
+        });
+    });
+
+    if constexpr (Trace::enabled) trace.sink.finish(labels.distances(), negativeCycle);
+    return negativeCycle;
+}
+
+// Trọng số lớn nhất còn dùng bucket Dial; lớn hơn thì mảng bucket vòng quá thưa
+const int DIAL_MAX_WEIGHT = 1 << 12;
+
+AlgorithmType engineForWeightRange(bool hasEdges, int minWeight, int maxWeight) {
+    if (!hasEdges) return AlgorithmType::ZERO_ONE_BFS;
+    if (minWeight < 0) return AlgorithmType::DIJKSTRA;
+    if (maxWeight <= 1) return AlgorithmType::ZERO_ONE_BFS;
+    if (maxWeight <= DIAL_MAX_WEIGHT) return AlgorithmType::DIJKSTRA_DIAL;
+    return AlgorithmType::DIJKSTRA_RADIX_HEAP;
+}
+} // namespace
+
+Algorithms::Algorithms(const Graph& g) : graph(g) {}
+
 std::vector<int> Algorithms::reconstructPath(int destination, const std::vector<int>& previousVertex) const {
     std::vector<int> path;
     int current = destination;
@@ -51,193 +265,697 @@ std::vector<int> Algorithms::reconstructPath(int destination, const std::vector<
 
 // Dijkstra 
 PathResult Algorithms::dijkstra(int start, bool showSteps) {
+    return runWithSteps(graph, showSteps, [&](auto& trace) {
+        return withGraphAdjacency(graph, [&](const auto& adj) { return runDijkstra<BinaryHeapQueue>(adj, start, trace); });
+    });
+}
+
+PathResult Algorithms::dijkstra(const CsrGraph& csr, int start, bool showSteps) {
+    return runWithSteps(graph, showSteps, [&](auto& trace) {
+        return runDijkstra<BinaryHeapQueue>(CsrView(csr), start, trace);
+    });
+}
+
+PathResult Algorithms::dijkstra(int start, TraceSink& sink) {
+    SinkTrace trace{sink};
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runDijkstra<BinaryHeapQueue>(adj, start, trace); });
+}
+
+template <typename Queue>
+PathResult Algorithms::dijkstraWith(int start, bool showSteps) {
+    return runWithSteps(graph, showSteps, [&](auto& trace) {
+        return withGraphAdjacency(graph, [&](const auto& adj) { return runDijkstra<Queue>(adj, start, trace); });
+    });
+}
+
+template <typename Queue>
+PathResult Algorithms::dijkstraWith(const CsrGraph& csr, int start, bool showSteps) {
+    return runWithSteps(graph, showSteps, [&](auto& trace) {
+        return runDijkstra<Queue>(CsrView(csr), start, trace);
+    });
+}
+
+template <typename Queue, typename Trace, typename Adjacency>
+PathResult Algorithms::runDijkstra(const Adjacency& adj, int start, Trace& trace) {
     PathResult result;
     result.startVertex = start;
-    int V = graph.getVertexCount();
-    const auto& adjList = graph.getAdjacencyList();
+    int V = adj.vertexCount();
+
+    DenseLabels labels(result, V);
+    Queue pq(V);
+    dijkstraLoop(adj, start, trace, labels, pq, -1);
+
+    result.success = true;
+    return result;
+}
+
+// Dial (bucket queue)
+PathResult Algorithms::dialDijkstra(int start) {
+    int minWeight = 0, maxWeight = 0;
+    graph.getWeightRange(minWeight, maxWeight);
+    if (minWeight < 0) {
+        PathResult result;
+        result.startVertex = start;
+        return result;
+    }
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runDial(adj, start, maxWeight); });
+}
+
+PathResult Algorithms::dialDijkstra(const CsrGraph& csr, int start) {
+    int minWeight = 0, maxWeight = 0;
+    csr.getWeightRange(minWeight, maxWeight);
+    if (minWeight < 0) {
+        PathResult result;
+        result.startVertex = start;
+        return result;
+    }
+    return runDial(CsrView(csr), start, maxWeight);
+}
+
+template <typename Adjacency>
+PathResult Algorithms::runDial(const Adjacency& adj, int start, int maxWeight) {
+    PathResult result;
+    result.startVertex = start;
+    int V = adj.vertexCount();
 
     const int INF = std::numeric_limits<int>::max();
     result.distances.assign(V, INF);
     result.previousVertex.assign(V, -1);
     result.distances[start] = 0;
 
-    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,std::greater<std::pair<int, int>>> pq;
-    pq.push({0, start});
+    // bucket d % (C + 1) chứa các đỉnh có khoảng cách tạm thời d; bản cũ bị bỏ qua khi lấy ra
+    const int bucketCount = maxWeight + 1;
+    std::vector<std::vector<int>> buckets(bucketCount);
+    std::vector<bool> visited(V, false);
+    buckets[0].push_back(start);
+    long long pending = 1;
+
+    for (int current = 0; pending > 0; current++) {
+        auto& bucket = buckets[current % bucketCount];
+        while (!bucket.empty()) {
+            int u = bucket.back();
+            bucket.pop_back();
+            pending--;
+            if (visited[u] || result.distances[u] != current) continue;
+            visited[u] = true;
+
+            adj.forEachEdge(u, [&](int v, int weight) {
+                int candidate = current + weight;
+                if (candidate < result.distances[v]) {
+                    result.distances[v] = candidate;
+                    result.previousVertex[v] = u;
+                    buckets[candidate % bucketCount].push_back(v);
+                    pending++;
+                }
+            });
+        }
+    }
+
+    result.success = true;
+    return result;
+}
 
-    if (showSteps) {
-        logStep(result.logs, 14, "              ======= THUẬT TOÁN DIJKSTRA =======");
-        logStep(result.logs, 11, "Đỉnh bắt đầu: " + graph.getVertexLabel(start));
-        logStep(result.logs, 7, "Khởi tạo khoảng cách: tất cả = INF, riêng đỉnh bắt đầu = 0");
+// 0-1 BFS
+PathResult Algorithms::zeroOneBfs(int start) {
+    int minWeight = 0, maxWeight = 0;
+    if (graph.getWeightRange(minWeight, maxWeight) && (minWeight < 0 || maxWeight > 1)) {
+        PathResult result;
+        result.startVertex = start;
+        return result;
+    }
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runZeroOneBfs(adj, start); });
+}
+
+PathResult Algorithms::zeroOneBfs(const CsrGraph& csr, int start) {
+    int minWeight = 0, maxWeight = 0;
+    if (csr.getWeightRange(minWeight, maxWeight) && (minWeight < 0 || maxWeight > 1)) {
+        PathResult result;
+        result.startVertex = start;
+        return result;
     }
+    return runZeroOneBfs(CsrView(csr), start);
+}
 
-    std::vector<bool> visited(V, false);
-    int iterations = 0;
+template <typename Adjacency>
+PathResult Algorithms::runZeroOneBfs(const Adjacency& adj, int start) {
+    PathResult result;
+    result.startVertex = start;
+    int V = adj.vertexCount();
 
-    while (!pq.empty()) {
-        auto [dist, u] = pq.top();
-        pq.pop();
+    const int INF = std::numeric_limits<int>::max();
+    result.distances.assign(V, INF);
+    result.previousVertex.assign(V, -1);
+    result.distances[start] = 0;
+
+    // cạnh 0 đẩy vào đầu deque, cạnh 1 đẩy vào cuối: deque luôn có khóa không giảm
+    std::deque<int> dq;
+    std::vector<bool> visited(V, false);
+    dq.push_back(start);
 
+    while (!dq.empty()) {
+        int u = dq.front();
+        dq.pop_front();
         if (visited[u]) continue;
         visited[u] = true;
-        iterations++;
 
-        if (showSteps) {
-            logStep(result.logs, 15, "");
-            logStep(result.logs, 11, "[Lần lặp " + std::to_string(iterations) + "]");
-            logStep(result.logs, 10, "Xử lý đỉnh: " + graph.getVertexLabel(u) +
-                                 " (khoảng cách = " + std::to_string(dist) + ")");
-        }
-
-        for (const auto& edge : adjList[u]) {
-            int v = edge.destination;
-            int weight = edge.weight;
-
-            if (result.distances[u] != INF && 
-                result.distances[u] + weight < result.distances[v]) {
-                
-                result.distances[v] = result.distances[u] + weight;
+        adj.forEachEdge(u, [&](int v, int weight) {
+            int candidate = result.distances[u] + weight;
+            if (candidate < result.distances[v]) {
+                result.distances[v] = candidate;
                 result.previousVertex[v] = u;
-                pq.push({result.distances[v], v});
-
-                if (showSteps) {
-                    logStep(result.logs, 13, "  Cập nhật: " + graph.getVertexLabel(u) + " -> " +
-                                         graph.getVertexLabel(v) +
-                                         " (khoảng cách mới = " + std::to_string(result.distances[v]) + ")");
+                if (weight == 0) {
+                    dq.push_front(v);
+                } else {
+                    dq.push_back(v);
                 }
             }
-        }
-
-        if (showSteps) {
-            logStep(result.logs, 15, "Khoảng cách sau lần lặp " + std::to_string(iterations) + ":");
-            auto table = formatDistanceTable(graph, result.distances);
-            for (const auto& line : table) {
-                logStep(result.logs, line.first, line.second);
-            }
-        }
+        });
     }
 
+    result.success = true;
+    return result;
+}
+
+AlgorithmType Algorithms::chooseDijkstraEngine() const {
+    int minWeight = 0, maxWeight = 0;
+    bool hasEdges = graph.getWeightRange(minWeight, maxWeight);
+    return engineForWeightRange(hasEdges, minWeight, maxWeight);
+}
+
+AlgorithmType Algorithms::chooseDijkstraEngine(const CsrGraph& csr) const {
+    int minWeight = 0, maxWeight = 0;
+    bool hasEdges = csr.getWeightRange(minWeight, maxWeight);
+    return engineForWeightRange(hasEdges, minWeight, maxWeight);
+}
+
+PathResult Algorithms::dijkstraAuto(int start, bool showSteps) {
     if (showSteps) {
-        logStep(result.logs, 15, "");
-        logStep(result.logs, 14, "                  === KHOẢNG CÁCH CUỐI ===");
-        for (int i = 0; i < V; i++) {
-            if (result.distances[i] == INF) {
-                logStep(result.logs, 11, "dist[" + std::to_string(i+1) + "] = INF (không tồn tại đường đi)");
-            } 
-            else {
-                logStep(result.logs, 11, "dist[" + std::to_string(i+1) + "] = " + std::to_string(result.distances[i]));
+        return dijkstra(start, true);
+    }
+    switch (chooseDijkstraEngine()) {
+        case AlgorithmType::ZERO_ONE_BFS: return zeroOneBfs(start);
+        case AlgorithmType::DIJKSTRA_DIAL: return dialDijkstra(start);
+        case AlgorithmType::DIJKSTRA_RADIX_HEAP: return dijkstraWith<RadixHeap>(start, false);
+        default: return dijkstra(start, false);
+    }
+}
+
+PathResult Algorithms::dijkstraAuto(const CsrGraph& csr, int start) {
+    switch (chooseDijkstraEngine(csr)) {
+        case AlgorithmType::ZERO_ONE_BFS: return zeroOneBfs(csr, start);
+        case AlgorithmType::DIJKSTRA_DIAL: return dialDijkstra(csr, start);
+        case AlgorithmType::DIJKSTRA_RADIX_HEAP: return dijkstraWith<RadixHeap>(csr, start, false);
+        default: return dijkstra(csr, start, false);
+    }
+}
+
+//dijkstra tới tập đích
+TargetQueryResult Algorithms::dijkstraToTargets(int source, const std::vector<int>& targets) const {
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runDijkstraToTargets(adj, source, targets); });
+}
+
+TargetQueryResult Algorithms::dijkstraToTargets(const CsrGraph& csr, int source, const std::vector<int>& targets) const {
+    return runDijkstraToTargets(CsrView(csr), source, targets);
+}
+
+template <typename Adjacency>
+TargetQueryResult Algorithms::runDijkstraToTargets(const Adjacency& adj, int source, const std::vector<int>& targets) const {
+    TargetQueryResult result;
+    result.source = source;
+    result.targets = targets;
+    result.distances.assign(targets.size(), -1);
+    result.paths.assign(targets.size(), {});
+
+    const int V = adj.vertexCount();
+    if (source < 0 || source >= V) return result;
+    for (int t : targets) {
+        if (t < 0 || t >= V) return result;
+    }
+
+    // Nhãn của đỉnh đã chạm tới: khoảng cách, đỉnh trước, đã chốt chưa
+    struct Label {
+        int distance;
+        int previous;
+        bool settled;
+    };
+    std::unordered_map<int, Label> labels;
+    std::unordered_map<int, int> pending;  // đích chưa chốt -> số lần xuất hiện trong targets
+    for (int t : targets) {
+        pending[t]++;
+    }
+
+    using Item = std::pair<int, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+    labels[source] = {0, -1, false};
+    pq.push({0, source});
+
+    while (!pq.empty() && !pending.empty()) {
+        auto [dist, u] = pq.top();
+        pq.pop();
+
+        Label& label = labels[u];
+        if (label.settled) continue;
+        label.settled = true;
+        result.settledVertices++;
+        pending.erase(u);
+
+        adj.forEachEdge(u, [&](int v, int weight) {
+            const long long candidate = static_cast<long long>(dist) + weight;
+            auto it = labels.find(v);
+            if (it == labels.end()) {
+                labels.emplace(v, Label{static_cast<int>(candidate), u, false});
+                pq.push({static_cast<int>(candidate), v});
+            } else if (!it->second.settled && candidate < it->second.distance) {
+                it->second.distance = static_cast<int>(candidate);
+                it->second.previous = u;
+                pq.push({static_cast<int>(candidate), v});
             }
+        });
+    }
+
+    for (size_t i = 0; i < targets.size(); i++) {
+        auto it = labels.find(targets[i]);
+        if (it == labels.end() || !it->second.settled) continue;
+        result.distances[i] = it->second.distance;
+        for (int v = targets[i]; v != -1; v = labels[v].previous) {
+            result.paths[i].push_back(v);
         }
+        std::reverse(result.paths[i].begin(), result.paths[i].end());
     }
 
     result.success = true;
     return result;
 }
 
+//dijkstra hai chiều
+PointToPointResult Algorithms::bidirectionalDijkstra(int source, int target) const {
+    return bidirectionalDijkstra(graph.getCsr(), graph.getReverseCsr(), source, target);
+}
+
+PointToPointResult Algorithms::bidirectionalDijkstra(const CsrGraph& forward, const CsrGraph& backward,
+                                                     int source, int target) const {
+    PointToPointResult result;
+    const int V = forward.getVertexCount();
+    if (source < 0 || source >= V || target < 0 || target >= V) return result;
+
+    if (source == target) {
+        result.found = true;
+        result.distance = 0;
+        result.path.push_back(source);
+        return result;
+    }
+
+    const long long INF = std::numeric_limits<long long>::max();
+    const CsrView views[2] = {CsrView(forward), CsrView(backward)};
+    std::vector<long long> dist[2] = {std::vector<long long>(V, INF), std::vector<long long>(V, INF)};
+    std::vector<int> parent[2] = {std::vector<int>(V, -1), std::vector<int>(V, -1)};
+    std::vector<char> settled[2] = {std::vector<char>(V, 0), std::vector<char>(V, 0)};
+    IndexedDaryHeap<4> queues[2] = {IndexedDaryHeap<4>(V), IndexedDaryHeap<4>(V)};
+
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    queues[0].push(0, source);
+    queues[1].push(0, target);
+
+    long long best = INF;  // độ dài đường ngắn nhất đã gặp (mu)
+    int meeting = -1;
+
+    while (!queues[0].empty() && !queues[1].empty()) {
+        // Điều kiện dừng chuẩn: top(F) + top(B) >= mu thì không còn đường nào ngắn hơn
+        if (best != INF && static_cast<long long>(queues[0].minKey()) + queues[1].minKey() >= best) break;
+
+        // Mở rộng phía có khóa đầu nhỏ hơn để hai quả cầu tìm kiếm cân bằng
+        const int side = queues[0].minKey() <= queues[1].minKey() ? 0 : 1;
+        const int other = 1 - side;
+        const int u = queues[side].pop().second;
+        settled[side][u] = 1;
+        result.settledVertices++;
+
+        const long long du = dist[side][u];
+        views[side].forEachEdge(u, [&](int v, int w) {
+            if (settled[side][v]) return;
+            const long long candidate = du + w;
+            if (candidate >= dist[side][v]) return;
+            dist[side][v] = candidate;
+            parent[side][v] = u;
+            queues[side].push(static_cast<int>(candidate), v);
+            // Nhãn hai phía chỉ giảm, nên chỉ cần xét lại mu khi nhãn phía này vừa giảm
+            if (dist[other][v] != INF && candidate + dist[other][v] < best) {
+                best = candidate + dist[other][v];
+                meeting = v;
+            }
+        });
+    }
+
+    if (meeting < 0) return result;
+
+    result.found = true;
+    result.distance = static_cast<int>(best);
+    for (int v = meeting; v != -1; v = parent[0][v]) {
+        result.path.push_back(v);
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    for (int v = parent[1][meeting]; v != -1; v = parent[1][v]) {
+        result.path.push_back(v);
+    }
+    return result;
+}
+
+// Johnson (thế năng lưu trong graph)
+PathResult Algorithms::johnsonDijkstra(int start, bool showSteps) {
+    return runWithSteps(graph, showSteps, [&](auto& trace) {
+        return withGraphAdjacency(graph, [&](const auto& adj) { return runJohnson(adj, start, trace); });
+    });
+}
+
+PathResult Algorithms::johnsonDijkstra(const CsrGraph& csr, int start) {
+    NoTrace trace;
+    return runJohnson(CsrView(csr), start, trace);
+}
+
+PathResult Algorithms::johnsonDijkstra(int start, TraceSink& sink) {
+    SinkTrace trace{sink};
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runJohnson(adj, start, trace); });
+}
+
+template <typename Trace, typename Adjacency>
+PathResult Algorithms::runJohnson(const Adjacency& adj, int start, Trace& trace) {
+    const VertexPotentials& potentials = graph.getPotentials();
+    if (!potentials.isUsable() || static_cast<int>(potentials.values.size()) != adj.vertexCount()) {
+        return runBellmanFord(adj, start, trace);
+    }
+
+    const int* h = potentials.values.data();
+    if constexpr (Trace::enabled) trace.sink.reweighted(potentials.passes);
+    PathResult result = runDijkstra<BinaryHeapQueue>(ReducedCostView<Adjacency>{adj, h}, start, trace);
+
+    // d(s, v) = d'(s, v) - h(s) + h(v)
+    const int INF = std::numeric_limits<int>::max();
+    for (size_t v = 0; v < result.distances.size(); v++) {
+        if (result.distances[v] != INF) {
+            result.distances[v] = result.distances[v] - h[start] + h[v];
+        }
+    }
+    if constexpr (Trace::enabled) trace.sink.restored(result.distances);
+    return result;
+}
+
 //bellman
 PathResult Algorithms::bellmanFord(int start, bool showSteps) {
+    return runWithSteps(graph, showSteps, [&](auto& trace) {
+        return withGraphAdjacency(graph, [&](const auto& adj) { return runBellmanFord(adj, start, trace); });
+    });
+}
+
+PathResult Algorithms::bellmanFord(const CsrGraph& csr, int start, bool showSteps) {
+    return runWithSteps(graph, showSteps, [&](auto& trace) {
+        return runBellmanFord(CsrView(csr), start, trace);
+    });
+}
+
+PathResult Algorithms::bellmanFord(int start, TraceSink& sink) {
+    SinkTrace trace{sink};
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runBellmanFord(adj, start, trace); });
+}
+
+template <typename Trace, typename Adjacency>
+PathResult Algorithms::runBellmanFord(const Adjacency& adj, int start, Trace& trace) {
     PathResult result;
     result.startVertex = start;
-    int V = graph.getVertexCount();
-    const auto& adjList = graph.getAdjacencyList();
+    int V = adj.vertexCount();
+
+    // bản gốc luôn chạy đủ V - 1 lượt, giữ nguyên để log và số đo không đổi
+    DenseLabels labels(result, V);
+    result.hasNegativeCycle = bellmanFordLoop(adj, start, trace, labels, false);
+
+    result.success = !result.hasNegativeCycle;
+    return result;
+}
+
+// SPFA
+PathResult Algorithms::spfa(int start, SpfaQueue discipline) {
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runSpfa(adj, start, discipline); });
+}
+
+PathResult Algorithms::spfa(const CsrGraph& csr, int start, SpfaQueue discipline) {
+    return runSpfa(CsrView(csr), start, discipline);
+}
+
+template <typename Adjacency>
+PathResult Algorithms::runSpfa(const Adjacency& adj, int start, SpfaQueue discipline) {
+    PathResult result;
+    result.startVertex = start;
+    int V = adj.vertexCount();
 
     const int INF = std::numeric_limits<int>::max();
     result.distances.assign(V, INF);
     result.previousVertex.assign(V, -1);
     result.distances[start] = 0;
-
-    if (showSteps) {
-        logStep(result.logs, 14, "           ======= THUẬT TOÁN BELLMAN-FORD =======");
-        logStep(result.logs, 11, "Đỉnh bắt đầu: " + graph.getVertexLabel(start));
-        logStep(result.logs, 7, "Khởi tạo khoảng cách: tất cả = INF, riêng đỉnh bắt đầu = 0");
-    }
-
-    for (int i = 0; i < V - 1; i++) {
-        bool updated = false;
-
-        if (showSteps) {
-            logStep(result.logs, 15, "");
-            logStep(result.logs, 11, "[Lượt " + std::to_string(i + 1) + "/" + std::to_string(V - 1) + "]");
+    std::vector<int>& dist = result.distances;
+
+    // Cây đường đi ngắn nhất: danh sách liên kết đôi theo thứ tự tiền tự, depth = -1 nếu không ở trong cây.
+    // Con cháu của v là các đỉnh liền sau v có độ sâu lớn hơn depth[v].
+    std::vector<int> nextInTree(V, -1);
+    std::vector<int> prevInTree(V, -1);
+    std::vector<int> depth(V, -1);
+    depth[start] = 0;
+
+    // Xóa khỏi hàng đợi bằng cờ: mục cũ còn trong deque bị bỏ qua khi lấy ra
+    std::deque<int> queue;
+    std::vector<char> queued(V, 0);
+    long long queuedSum = 0;    // tổng nhãn các đỉnh trong hàng, cho LLL
+    int queuedCount = 0;
+    const bool smallLabelFirst = discipline == SpfaQueue::SLF || discipline == SpfaQueue::SLF_LLL;
+    const bool largeLabelLast = discipline == SpfaQueue::LLL || discipline == SpfaQueue::SLF_LLL;
+
+    auto dropStale = [&]() {
+        while (!queue.empty() && !queued[queue.front()]) queue.pop_front();
+    };
+    auto enqueue = [&](int v) {
+        queued[v] = 1;
+        queuedSum += dist[v];
+        queuedCount++;
+        dropStale();
+        if (smallLabelFirst && !queue.empty() && dist[v] < dist[queue.front()]) {
+            queue.push_front(v);
+        } else {
+            queue.push_back(v);
         }
+    };
+    auto leaveQueue = [&](int v) {
+        queued[v] = 0;
+        queuedSum -= dist[v];
+        queuedCount--;
+    };
+
+    enqueue(start);
+    bool negativeCycle = false;
+
+    while (queuedCount > 0 && !negativeCycle) {
+        dropStale();
+        if (largeLabelLast) {
+            // quay đầu hàng xuống cuối tới khi gặp đỉnh có nhãn không lớn hơn trung bình
+            for (int rotations = 0; rotations < queuedCount; rotations++) {
+                int front = queue.front();
+                if (static_cast<long long>(dist[front]) * queuedCount <= queuedSum) break;
+                queue.pop_front();
+                queue.push_back(front);
+                dropStale();
+            }
+        }
+        int u = queue.front();
+        queue.pop_front();
+        leaveQueue(u);
 
-        for (int u = 0; u < V; u++) {
-            for (const auto& edge : adjList[u]) {
-                int v = edge.destination;
-                int weight = edge.weight;
-
-                if (result.distances[u] != INF && 
-                    result.distances[u] + weight < result.distances[v]) {
-                    
-                    result.distances[v] = result.distances[u] + weight;
-                    result.previousVertex[v] = u;
-                    updated = true;
+        adj.forEachEdge(u, [&](int v, int weight) {
+            if (negativeCycle || dist[u] + weight >= dist[v]) return;
 
-                    if (showSteps) {
-                        logStep(result.logs, 13, "  Cập nhật: " + graph.getVertexLabel(u) + " -> " +
-                                             graph.getVertexLabel(v) +
-                                             " (khoảng cách mới = " + std::to_string(result.distances[v]) + ")");
+            if (depth[v] >= 0) {
+                if (v == u) {
+                    negativeCycle = true;
+                    return;
+                }
+                // tháo cây con của v; gặp u nghĩa là v là tổ tiên của u: chu trình âm
+                int x = nextInTree[v];
+                while (x != -1 && depth[x] > depth[v]) {
+                    if (x == u) {
+                        negativeCycle = true;
+                        return;
                     }
+                    depth[x] = -1;
+                    if (queued[x]) leaveQueue(x);
+                    x = nextInTree[x];
                 }
+                int before = prevInTree[v];
+                nextInTree[before] = x;
+                if (x != -1) prevInTree[x] = before;
             }
-        }
 
-        if (!updated && showSteps) {
-            logStep(result.logs, 7, "  (Không có cập nhật ở lượt này - có thể dừng sớm)");
-        }
+            int newDistance = dist[u] + weight;
+            if (queued[v]) queuedSum += static_cast<long long>(newDistance) - dist[v];
+            dist[v] = newDistance;
+            result.previousVertex[v] = u;
 
-        if (showSteps) {
-            logStep(result.logs, 15, "Bảng khoảng cách sau lượt " + std::to_string(i + 1) + ":");
-            auto table = formatDistanceTable(graph, result.distances);
-            for (const auto& line : table) {
-                logStep(result.logs, line.first, line.second);
-            }
-        }
-    }
+            // v thành con của u, đứng ngay sau u theo thứ tự tiền tự
+            depth[v] = depth[u] + 1;
+            prevInTree[v] = u;
+            nextInTree[v] = nextInTree[u];
+            if (nextInTree[u] != -1) prevInTree[nextInTree[u]] = v;
+            nextInTree[u] = v;
 
-    result.hasNegativeCycle = false;
-    if (showSteps) {
-        logStep(result.logs, 15, "");
-        logStep(result.logs, 14, "=== KIỂM TRA CHU TRÌNH ÂM ===");
+            if (!queued[v]) enqueue(v);
+        });
     }
 
-    for (int u = 0; u < V; u++) {
-        for (const auto& edge : adjList[u]) {
-            int v = edge.destination;
-            int weight = edge.weight;
-
-            if (result.distances[u] != INF && 
-                result.distances[u] + weight < result.distances[v]) {
-                result.hasNegativeCycle = true;
-
-                if (showSteps) {
-                    logStep(result.logs, 12, "PHÁT HIỆN CHU TRÌNH ÂM!");
-                    logStep(result.logs, 12, "Cạnh: " + graph.getVertexLabel(u) + " -> " +
-                                         graph.getVertexLabel(v) +
-                                         " (trọng số = " + std::to_string(weight) + ")");
-                }
-            }
-        }
-    }
+    result.hasNegativeCycle = negativeCycle;
+    result.success = !negativeCycle;
+    return result;
+}
 
-    if (!result.hasNegativeCycle && showSteps) {
-        logStep(result.logs, 10, "Không phát hiện chu trình âm.");
-    }
+// Goldberg-Radzik
+PathResult Algorithms::goldbergRadzik(int start) {
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runGoldbergRadzik(adj, start); });
+}
 
-    if (showSteps) {
-        logStep(result.logs, 15, "");
-        logStep(result.logs, 14, "=== KHOẢNG CÁCH CUỐI ===");
-        for (int i = 0; i < V; i++) {
-            if (result.distances[i] == INF) {
-                logStep(result.logs, 11, graph.getVertexLabel(i) + " = INF (không tới được)");
-            } else {
-                logStep(result.logs, 11, graph.getVertexLabel(i) + " = " + std::to_string(result.distances[i]));
+PathResult Algorithms::goldbergRadzik(const CsrGraph& csr, int start) {
+    return runGoldbergRadzik(CsrView(csr), start);
+}
+
+template <typename Adjacency>
+PathResult Algorithms::runGoldbergRadzik(const Adjacency& adj, int start) {
+    PathResult result;
+    result.startVertex = start;
+    int V = adj.vertexCount();
+
+    const int INF = std::numeric_limits<int>::max();
+    result.distances.assign(V, INF);
+    result.previousVertex.assign(V, -1);
+    result.distances[start] = 0;
+    std::vector<int>& dist = result.distances;
+
+    std::vector<int> pending{start};    // B
+    std::vector<char> inPending(V, 0);
+    inPending[start] = 1;
+    std::vector<int> roots;
+    std::vector<int> order;             // hậu thứ tự DFS; duyệt ngược lại là thứ tự tô-pô
+    std::vector<int> stack;             // ~v: đã duyệt xong các con của v
+    std::vector<char> state(V, 0);      // 0: chưa thăm, 1: đang trên đường DFS, 2: xong
+    bool negativeCycle = false;
+    int passes = 0;
+
+    while (!pending.empty() && !negativeCycle) {
+        if (++passes > V) {
+            negativeCycle = true;
+            break;
+        }
+
+        // chỉ giữ các đỉnh còn cung nới được
+        roots.clear();
+        for (int v : pending) {
+            inPending[v] = 0;
+            bool improving = false;
+            adj.forEachEdge(v, [&](int w, int weight) {
+                if (dist[v] + weight < dist[w]) improving = true;
+            });
+            if (improving) roots.push_back(v);
+        }
+        pending.clear();
+
+        // DFS trên các cung có chi phí rút gọn <= 0 (đỉnh chưa có nhãn coi như chi phí âm)
+        order.clear();
+        for (int root : roots) {
+            if (state[root] != 0) continue;
+            stack.push_back(root);
+            while (!stack.empty() && !negativeCycle) {
+                int x = stack.back();
+                stack.pop_back();
+                if (x < 0) {
+                    state[~x] = 2;
+                    order.push_back(~x);
+                    continue;
+                }
+                if (state[x] != 0) continue;
+                state[x] = 1;
+                stack.push_back(~x);
+                if (dist[x] == INF) continue;
+                adj.forEachEdge(x, [&](int w, int weight) {
+                    if (dist[w] != INF && dist[x] + weight > dist[w]) return;
+                    if (state[w] == 0) {
+                        stack.push_back(w);
+                    } else if (state[w] == 1 && dist[x] + weight < dist[w]) {
+                        // w là tổ tiên của x: chu trình gồm các cung <= 0 và một cung < 0
+                        negativeCycle = true;
+                    }
+                });
             }
+            if (negativeCycle) break;
+        }
+        for (int v : order) state[v] = 0;
+        for (int x : stack) state[x < 0 ? ~x : x] = 0;
+        stack.clear();
+        if (negativeCycle) break;
+
+        // duyệt theo thứ tự tô-pô
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            int u = *it;
+            if (dist[u] == INF) continue;
+            adj.forEachEdge(u, [&](int v, int weight) {
+                if (dist[u] + weight < dist[v]) {
+                    dist[v] = dist[u] + weight;
+                    result.previousVertex[v] = u;
+                    if (!inPending[v]) {
+                        inPending[v] = 1;
+                        pending.push_back(v);
+                    }
+                }
+            });
         }
     }
 
-    result.success = !result.hasNegativeCycle;
+    result.hasNegativeCycle = negativeCycle;
+    result.success = !negativeCycle;
     return result;
 }
 
+// Các bản dùng workspace: cùng vòng lặp với bản trả về PathResult, nhãn nằm trong workspace
+int Algorithms::dijkstra(int start, QueryWorkspace& workspace, int target) const {
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runDijkstra(adj, start, workspace, target); });
+}
+
+int Algorithms::dijkstra(const CsrGraph& csr, int start, QueryWorkspace& workspace, int target) const {
+    return runDijkstra(CsrView(csr), start, workspace, target);
+}
+
+template <typename Adjacency>
+int Algorithms::runDijkstra(const Adjacency& adj, int start, QueryWorkspace& workspace, int target) const {
+    workspace.begin(adj.vertexCount());
+    if (start < 0 || start >= adj.vertexCount()) return 0;
+
+    // heap nhị phân xóa lười như BinaryHeapQueue, trên vector của workspace: không cấp phát sau vài truy vấn đầu
+    WorkspaceLabels labels(workspace);
+    BorrowedHeapQueue pq(workspace.queue());
+    NoTrace trace;
+    return dijkstraLoop(adj, start, trace, labels, pq, target);
+}
+
+bool Algorithms::bellmanFord(int start, QueryWorkspace& workspace) const {
+    return withGraphAdjacency(graph, [&](const auto& adj) { return runBellmanFord(adj, start, workspace); });
+}
+
+bool Algorithms::bellmanFord(const CsrGraph& csr, int start, QueryWorkspace& workspace) const {
+    return runBellmanFord(CsrView(csr), start, workspace);
+}
+
+template <typename Adjacency>
+bool Algorithms::runBellmanFord(const Adjacency& adj, int start, QueryWorkspace& workspace) const {
+    workspace.begin(adj.vertexCount());
+    if (start < 0 || start >= adj.vertexCount()) return true;
+
+    WorkspaceLabels labels(workspace);
+    NoTrace trace;
+    return !bellmanFordLoop(adj, start, trace, labels, true);
+}
+
 std::vector<int> Algorithms::getShortestPath(const PathResult& result, int destination) const {
     if (destination < 0 || destination >= result.previousVertex.size()) {
         return {};
@@ -258,3 +976,16 @@ int Algorithms::getDistance(const PathResult& result, int destination) const {
     return result.distances[destination];
 }
 
+// Các hàng đợi có sẵn trong priority_queues.h
+template PathResult Algorithms::dijkstraWith<BinaryHeapQueue>(int, bool);
+template PathResult Algorithms::dijkstraWith<BinaryHeapQueue>(const CsrGraph&, int, bool);
+template PathResult Algorithms::dijkstraWith<IndexedDaryHeap<2>>(int, bool);
+template PathResult Algorithms::dijkstraWith<IndexedDaryHeap<2>>(const CsrGraph&, int, bool);
+template PathResult Algorithms::dijkstraWith<IndexedDaryHeap<4>>(int, bool);
+template PathResult Algorithms::dijkstraWith<IndexedDaryHeap<4>>(const CsrGraph&, int, bool);
+template PathResult Algorithms::dijkstraWith<IndexedDaryHeap<8>>(int, bool);
+template PathResult Algorithms::dijkstraWith<IndexedDaryHeap<8>>(const CsrGraph&, int, bool);
+template PathResult Algorithms::dijkstraWith<PairingHeap>(int, bool);
+template PathResult Algorithms::dijkstraWith<PairingHeap>(const CsrGraph&, int, bool);
+template PathResult Algorithms::dijkstraWith<RadixHeap>(int, bool);
+template PathResult Algorithms::dijkstraWith<RadixHeap>(const CsrGraph&, int, bool);
@@ -0,0 +1,143 @@
+#include "../lib/all_pairs.h"
+#include "../lib/potentials.h"
+#include "../lib/priority_queues.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace {
+const int INF = std::numeric_limits<int>::max();
+
+// Bộ nhớ làm việc của một luồng, dùng lại cho mọi nguồn luồng đó nhận
+struct Workspace {
+    IndexedDaryHeap<4> queue;
+    std::vector<int> parent;
+    std::vector<int> settledOrder;
+
+    explicit Workspace(int V) : queue(V), parent(V, -1) { settledOrder.reserve(V); }
+};
+
+// Dijkstra từ source ghi thẳng vào dòng dist (đã đặt INF); next (nếu có) nhận đỉnh kế
+void solveRow(const CsrGraph& csr, int source, int* dist, int* next, Workspace& work) {
+    const int* offsets = csr.getOffsets();
+    const int* targets = csr.getTargets();
+    const int* weights = csr.getWeights();
+
+    dist[source] = 0;
+    work.parent[source] = -1;
+    work.queue.push(0, source);
+    while (!work.queue.empty()) {
+        auto [d, u] = work.queue.pop();
+        work.settledOrder.push_back(u);
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = targets[i];
+            int candidate = d + weights[i];
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                work.parent[v] = u;
+                work.queue.push(candidate, v);
+            }
+        }
+    }
+
+    // thứ tự chốt là thứ tự topo của cây đường đi: cha luôn có đỉnh kế trước con
+    if (next != nullptr) {
+        for (int v : work.settledOrder) {
+            int p = work.parent[v];
+            next[v] = p < 0 ? -1 : (p == source ? v : next[p]);
+        }
+    }
+    work.settledOrder.clear();
+}
+} // namespace
+
+AllPairsShortestPaths::AllPairsShortestPaths(const Graph& g)
+    : graph(g), V(0), hasNegativeCycle(false) {}
+
+bool AllPairsShortestPaths::run(int threads, bool withNextHop) {
+    V = graph.getVertexCount();
+    hasNegativeCycle = false;
+    distances.clear();
+    nextHops.clear();
+    if (V == 0) return false;
+
+    // trọng số rút gọn tính một lần vào ảnh chụp CSR riêng, các luồng chỉ đọc
+    CsrGraph csr = graph.getCsr();
+    std::vector<int> reducedWeights;
+    const int* h = nullptr;
+    if (graph.hasNegativeWeights()) {
+        const VertexPotentials& potentials = graph.getPotentials();
+        if (!potentials.isUsable()) {
+            hasNegativeCycle = potentials.hasNegativeCycle;
+            return false;
+        }
+        h = potentials.values.data();
+        const int* offsets = csr.getOffsets();
+        const int* targets = csr.getTargets();
+        const int* weights = csr.getWeights();
+        reducedWeights.resize(csr.getEdgeCount());
+        for (int u = 0; u < V; u++) {
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                reducedWeights[i] = weights[i] + h[u] - h[targets[i]];
+            }
+        }
+        csr = CsrGraph(V, csr.getEdgeCount(), offsets, targets, reducedWeights.data(),
+                       std::make_shared<CsrGraph>(csr));
+    }
+
+    const size_t cells = static_cast<size_t>(V) * V;
+    distances.assign(cells, INF);
+    if (withNextHop) nextHops.assign(cells, -1);
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    threads = std::min(threads, V);
+
+    std::atomic<int> nextSource(0);
+    auto worker = [&]() {
+        Workspace work(V);
+        for (int s = nextSource++; s < V; s = nextSource++) {
+            int* dist = distances.data() + static_cast<size_t>(s) * V;
+            int* next = withNextHop ? nextHops.data() + static_cast<size_t>(s) * V : nullptr;
+            solveRow(csr, s, dist, next, work);
+            if (h != nullptr) {
+                // d(s, t) = d'(s, t) - h(s) + h(t)
+                for (int t = 0; t < V; t++) {
+                    if (dist[t] != INF) dist[t] = dist[t] - h[s] + h[t];
+                }
+            }
+        }
+    };
+
+    if (threads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back(worker);
+        }
+        for (auto& w : workers) w.join();
+    }
+    return true;
+}
+
+std::vector<int> AllPairsShortestPaths::path(int source, int target) const {
+    std::vector<int> result;
+    if (nextHops.empty() || source < 0 || source >= V || target < 0 || target >= V) return result;
+    if (distance(source, target) == INF) return result;
+
+    result.push_back(source);
+    for (int at = source; at != target;) {
+        at = nextHop(at, target);
+        if (at < 0 || static_cast<int>(result.size()) > V) return {};
+        result.push_back(at);
+    }
+    return result;
+}
+
+long long AllPairsShortestPaths::memoryUsageBytes() const {
+    return static_cast<long long>(distances.capacity() + nextHops.capacity()) * sizeof(int);
+}
@@ -0,0 +1,338 @@
+#include "../lib/alt_landmarks.h"
+#include "../lib/priority_queues.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+
+namespace {
+const int INF = std::numeric_limits<int>::max();
+const char ALT_MAGIC[8] = {'P', 'B', 'L', 'A', 'L', 'T', '\0', '\0'};
+const std::uint32_t ALT_VERSION = 1;
+
+struct AltFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t vertexCount;
+    std::int32_t edgeCount;
+    std::int32_t landmarkCount;
+    std::uint64_t fingerprint;
+};
+
+std::uint64_t fnv1a(std::uint64_t hash, const void* data, std::uint64_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::uint64_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::uint64_t csrFingerprint(const CsrGraph& csr) {
+    const std::uint64_t V = static_cast<std::uint64_t>(csr.getVertexCount());
+    const std::uint64_t E = static_cast<std::uint64_t>(csr.getEdgeCount());
+    std::uint64_t hash = 1469598103934665603ULL;
+    hash = fnv1a(hash, csr.getOffsets(), (V + 1) * sizeof(int));
+    hash = fnv1a(hash, csr.getTargets(), E * sizeof(int));
+    hash = fnv1a(hash, csr.getWeights(), E * sizeof(int));
+    return hash;
+}
+
+// Gộp cận dưới của một landmark vào `bound`; false nếu suy ra được v không tới được t
+bool accumulateBound(int fromV, int fromT, int toV, int toT, int& bound) {
+    if (fromV != INF) {
+        if (fromT == INF) return false;          // L tới được v nhưng không tới được t
+        bound = std::max(bound, fromT - fromV);
+    }
+    if (toT != INF) {
+        if (toV == INF) return false;            // t tới được L nhưng v thì không
+        bound = std::max(bound, toV - toT);
+    }
+    return true;
+}
+
+// Bảng tạm theo từng landmark trong lúc chọn; cuối cùng mới chuyển sang dạng theo đỉnh
+struct LandmarkTables {
+    Algorithms& algorithms;
+    const CsrGraph& forward;
+    const CsrGraph& backward;
+    std::vector<int> landmarks;
+    std::vector<std::vector<int>> from;
+    std::vector<std::vector<int>> to;
+
+    void add(int vertex) {
+        landmarks.push_back(vertex);
+        from.push_back(algorithms.dijkstraWith<IndexedDaryHeap<4>>(forward, vertex, false).distances);
+        to.push_back(algorithms.dijkstraWith<IndexedDaryHeap<4>>(backward, vertex, false).distances);
+    }
+
+    int lowerBound(int v, int t) const {
+        int bound = 0;
+        for (size_t i = 0; i < landmarks.size(); i++) {
+            if (!accumulateBound(from[i][v], from[i][t], to[i][v], to[i][t], bound)) return INF;
+        }
+        return bound;
+    }
+
+    // Đỉnh xa các landmark hiện có nhất theo min_i(d(L_i, v) + d(v, L_i))
+    int farthestVertex() const {
+        const int V = forward.getVertexCount();
+        int best = -1;
+        long long bestScore = -1;
+        for (int v = 0; v < V; v++) {
+            if (std::find(landmarks.begin(), landmarks.end(), v) != landmarks.end()) continue;
+            long long score = std::numeric_limits<long long>::max();
+            for (size_t i = 0; i < landmarks.size(); i++) {
+                long long roundTrip = (from[i][v] == INF || to[i][v] == INF)
+                    ? std::numeric_limits<long long>::max()
+                    : static_cast<long long>(from[i][v]) + to[i][v];
+                score = std::min(score, roundTrip);
+            }
+            if (score > bestScore) {
+                bestScore = score;
+                best = v;
+            }
+        }
+        return best;
+    }
+};
+
+void selectFarthest(LandmarkTables& tables, int count, std::mt19937& rng) {
+    const int V = tables.forward.getVertexCount();
+    // landmark đầu: đỉnh xa nhất tính từ một đỉnh ngẫu nhiên
+    int root = std::uniform_int_distribution<int>(0, V - 1)(rng);
+    auto distances = tables.algorithms.dijkstraWith<IndexedDaryHeap<4>>(tables.forward, root, false).distances;
+    int first = root;
+    for (int v = 0; v < V; v++) {
+        if (distances[v] != INF && distances[v] > distances[first]) first = v;
+    }
+    tables.add(first);
+
+    while (static_cast<int>(tables.landmarks.size()) < count) {
+        tables.add(tables.farthestVertex());
+    }
+}
+
+void selectAvoid(LandmarkTables& tables, int count, std::mt19937& rng) {
+    const int V = tables.forward.getVertexCount();
+    std::uniform_int_distribution<int> pick(0, V - 1);
+    std::vector<char> isLandmark(V, 0);
+
+    while (static_cast<int>(tables.landmarks.size()) < count) {
+        int root = pick(rng);
+        PathResult tree = tables.algorithms.dijkstraWith<IndexedDaryHeap<4>>(tables.forward, root, false);
+
+        // cây đường đi ngắn nhất gốc root, duyệt theo BFS để cộng dồn từ lá lên
+        std::vector<std::vector<int>> children(V);
+        for (int v = 0; v < V; v++) {
+            if (tree.previousVertex[v] >= 0) children[tree.previousVertex[v]].push_back(v);
+        }
+        std::vector<int> order = {root};
+        for (size_t i = 0; i < order.size(); i++) {
+            for (int c : children[order[i]]) order.push_back(c);
+        }
+
+        // size(v) = tổng (d(root, u) - cận dưới(root, u)) trên cây con; bằng 0 nếu cây con chứa landmark
+        std::vector<long long> size(V, 0);
+        std::vector<char> hasLandmark(V, 0);
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            int v = *it;
+            int bound = tables.lowerBound(root, v);
+            size[v] += tree.distances[v] - (bound == INF ? 0 : bound);
+            hasLandmark[v] |= isLandmark[v];
+            int parent = tree.previousVertex[v];
+            if (parent >= 0) {
+                hasLandmark[parent] |= hasLandmark[v];
+                size[parent] += size[v];
+            }
+        }
+        for (int v : order) {
+            if (hasLandmark[v]) size[v] = 0;
+        }
+
+        int chosen = -1;
+        if (size[root] > 0) {
+            chosen = root;
+            while (true) {
+                int next = -1;
+                for (int c : children[chosen]) {
+                    if (size[c] > 0 && (next < 0 || size[c] > size[next])) next = c;
+                }
+                if (next < 0) break;
+                chosen = next;
+            }
+        }
+        if (chosen < 0 || isLandmark[chosen]) {
+            chosen = tables.landmarks.empty() ? root : tables.farthestVertex();
+        }
+        isLandmark[chosen] = 1;
+        tables.add(chosen);
+    }
+}
+} // namespace
+
+AltIndex::AltIndex() : V(0), E(0), landmarkCount(0), fingerprint(0) {}
+
+bool AltIndex::build(const Graph& graph, int count, LandmarkSelection selection) {
+    *this = AltIndex();
+    if (!graph.isValid() || graph.hasNegativeWeights() || count <= 0) return false;
+
+    CsrGraph forward(graph);
+    CsrGraph backward = forward.reversed();
+    Algorithms algorithms(graph);
+    const int vertices = forward.getVertexCount();
+    count = std::min(count, vertices);
+
+    std::mt19937 rng(1);
+    LandmarkTables tables{algorithms, forward, backward, {}, {}, {}};
+    if (selection == LandmarkSelection::FARTHEST) {
+        selectFarthest(tables, count, rng);
+    } else {
+        selectAvoid(tables, count, rng);
+    }
+
+    V = vertices;
+    E = forward.getEdgeCount();
+    landmarkCount = count;
+    fingerprint = csrFingerprint(forward);
+    landmarks = tables.landmarks;
+    fromLandmark.resize(static_cast<size_t>(V) * count);
+    toLandmark.resize(static_cast<size_t>(V) * count);
+    for (int v = 0; v < V; v++) {
+        for (int i = 0; i < count; i++) {
+            fromLandmark[static_cast<size_t>(v) * count + i] = tables.from[i][v];
+            toLandmark[static_cast<size_t>(v) * count + i] = tables.to[i][v];
+        }
+    }
+    return true;
+}
+
+bool AltIndex::save(const std::string& filename) const {
+    if (!isBuilt()) return false;
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    AltFileHeader header;
+    std::memcpy(header.magic, ALT_MAGIC, sizeof(header.magic));
+    header.version = ALT_VERSION;
+    header.vertexCount = V;
+    header.edgeCount = E;
+    header.landmarkCount = landmarkCount;
+    header.fingerprint = fingerprint;
+
+    const std::streamsize tableBytes = static_cast<std::streamsize>(fromLandmark.size() * sizeof(int));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(landmarks.data()), landmarkCount * sizeof(int));
+    file.write(reinterpret_cast<const char*>(fromLandmark.data()), tableBytes);
+    file.write(reinterpret_cast<const char*>(toLandmark.data()), tableBytes);
+    return file.good();
+}
+
+bool AltIndex::load(const std::string& filename, const CsrGraph& csr) {
+    *this = AltIndex();
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    AltFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, ALT_MAGIC, sizeof(header.magic)) != 0 || header.version != ALT_VERSION) return false;
+    if (header.vertexCount != csr.getVertexCount() || header.edgeCount != csr.getEdgeCount()) return false;
+    if (header.landmarkCount <= 0 || header.landmarkCount > header.vertexCount) return false;
+    if (header.fingerprint != csrFingerprint(csr)) return false;
+
+    const size_t cells = static_cast<size_t>(header.vertexCount) * header.landmarkCount;
+    std::vector<int> readLandmarks(header.landmarkCount);
+    std::vector<int> readFrom(cells);
+    std::vector<int> readTo(cells);
+    file.read(reinterpret_cast<char*>(readLandmarks.data()), header.landmarkCount * sizeof(int));
+    file.read(reinterpret_cast<char*>(readFrom.data()), static_cast<std::streamsize>(cells * sizeof(int)));
+    file.read(reinterpret_cast<char*>(readTo.data()), static_cast<std::streamsize>(cells * sizeof(int)));
+    if (!file) return false;
+
+    V = header.vertexCount;
+    E = header.edgeCount;
+    landmarkCount = header.landmarkCount;
+    fingerprint = header.fingerprint;
+    landmarks = std::move(readLandmarks);
+    fromLandmark = std::move(readFrom);
+    toLandmark = std::move(readTo);
+    return true;
+}
+
+long long AltIndex::memoryUsageBytes() const {
+    return static_cast<long long>(landmarks.size() + fromLandmark.size() + toLandmark.size()) * sizeof(int);
+}
+
+int AltIndex::lowerBound(int v, int target) const {
+    const int* fromV = &fromLandmark[static_cast<size_t>(v) * landmarkCount];
+    const int* fromT = &fromLandmark[static_cast<size_t>(target) * landmarkCount];
+    const int* toV = &toLandmark[static_cast<size_t>(v) * landmarkCount];
+    const int* toT = &toLandmark[static_cast<size_t>(target) * landmarkCount];
+    int bound = 0;
+    for (int i = 0; i < landmarkCount; i++) {
+        if (!accumulateBound(fromV[i], fromT[i], toV[i], toT[i], bound)) return INF;
+    }
+    return bound;
+}
+
+PointToPointResult AltIndex::query(const CsrGraph& csr, int source, int target) const {
+    PointToPointResult result;
+    if (!isBuilt() || csr.getVertexCount() != V) return result;
+    if (source < 0 || source >= V || target < 0 || target >= V) return result;
+
+    const long long UNREACHED = std::numeric_limits<long long>::max();
+    std::vector<long long> dist(V, UNREACHED);
+    std::vector<int> parent(V, -1);
+    std::vector<int> potential(V, -1);   // -1: chưa tính
+    std::vector<char> settled(V, 0);
+
+    auto potentialOf = [&](int v) {
+        if (potential[v] < 0) potential[v] = lowerBound(v, target);
+        return potential[v];
+    };
+    if (potentialOf(source) == INF) return result;
+
+    using Item = std::pair<long long, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+    dist[source] = 0;
+    pq.push({potentialOf(source), source});
+
+    const int* offsets = csr.getOffsets();
+    const int* targets = csr.getTargets();
+    const int* weights = csr.getWeights();
+
+    while (!pq.empty()) {
+        int u = pq.top().second;
+        pq.pop();
+        if (settled[u]) continue;
+        settled[u] = 1;
+        result.settledVertices++;
+        if (u == target) break;
+
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = targets[i];
+            if (settled[v]) continue;
+            int pv = potentialOf(v);
+            if (pv == INF) continue;
+            long long candidate = dist[u] + weights[i];
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                parent[v] = u;
+                pq.push({candidate + pv, v});
+            }
+        }
+    }
+
+    if (!settled[target]) return result;
+
+    result.found = true;
+    result.distance = static_cast<int>(dist[target]);
+    for (int v = target; v != -1; v = parent[v]) {
+        result.path.push_back(v);
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
@@ -0,0 +1,200 @@
+#include "../lib/binary_graph.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "../lib/mapped_file.h"
+
+namespace {
+const std::uint64_t SECTION_ALIGN = 64;
+const std::uint64_t FNV_OFFSET = 1469598103934665603ULL;
+const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+std::uint64_t alignUp(std::uint64_t pos) {
+    return (pos + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+}
+
+std::uint64_t fnv1a(std::uint64_t hash, const void* data, std::uint64_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::uint64_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+bool hostIsLittleEndian() {
+    const std::uint32_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Ghi tuần tự, tự chèn byte 0 để căn lề và cộng dồn checksum
+class SectionWriter {
+public:
+    explicit SectionWriter(std::ofstream& f) : file(f), pos(sizeof(BinaryGraphHeader)), hash(FNV_OFFSET) {}
+
+    std::uint64_t begin() {
+        std::uint64_t target = alignUp(pos);
+        static const char zeros[SECTION_ALIGN] = {};
+        write(zeros, target - pos);
+        return pos;
+    }
+
+    void write(const void* data, std::uint64_t bytes) {
+        if (bytes == 0) return;
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        hash = fnv1a(hash, data, bytes);
+        pos += bytes;
+    }
+
+    std::uint64_t position() const { return pos; }
+    std::uint64_t checksum() const { return hash; }
+
+private:
+    std::ofstream& file;
+    std::uint64_t pos;
+    std::uint64_t hash;
+};
+} // namespace
+
+bool writeBinaryGraph(const Graph& graph, const std::string& filename) {
+    if (!hostIsLittleEndian()) {
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    CsrGraph csr(graph);
+    const int V = csr.getVertexCount();
+    const int E = csr.getEdgeCount();
+
+    BinaryGraphHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic));
+    header.version = BINARY_GRAPH_VERSION;
+    header.endianTag = BINARY_GRAPH_ENDIAN_TAG;
+    header.vertexCount = V;
+    header.edgeCount = E;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    SectionWriter out(file);
+    header.offsetsPos = out.begin();
+    out.write(csr.getOffsets(), (static_cast<std::uint64_t>(V) + 1) * sizeof(int));
+    header.targetsPos = out.begin();
+    out.write(csr.getTargets(), static_cast<std::uint64_t>(E) * sizeof(int));
+    header.weightsPos = out.begin();
+    out.write(csr.getWeights(), static_cast<std::uint64_t>(E) * sizeof(int));
+
+    std::vector<std::uint32_t> labelOffsets(static_cast<size_t>(V) + 1, 0);
+    std::string blob;
+    for (int v = 0; v < V; v++) {
+        blob += graph.getVertexLabel(v);
+        labelOffsets[v + 1] = static_cast<std::uint32_t>(blob.size());
+    }
+    header.labelOffsetsPos = out.begin();
+    out.write(labelOffsets.data(), labelOffsets.size() * sizeof(std::uint32_t));
+    header.labelBlobPos = out.begin();
+    header.labelBlobBytes = blob.size();
+    out.write(blob.data(), blob.size());
+
+    header.fileBytes = out.position();
+    header.checksum = out.checksum();
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return file.good();
+}
+
+BinaryGraphFile::BinaryGraphFile() : header(nullptr), labelOffsets(nullptr), labelBlob(nullptr) {}
+
+bool BinaryGraphFile::open(const std::string& filename, bool verify) {
+    close();
+    if (!hostIsLittleEndian()) {
+        return false;
+    }
+
+    auto m = std::make_shared<MappedFile>();
+    if (!m->open(filename) || m->size() < sizeof(BinaryGraphHeader)) {
+        return false;
+    }
+
+    const auto* h = reinterpret_cast<const BinaryGraphHeader*>(m->data());
+    if (std::memcmp(h->magic, BINARY_GRAPH_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != BINARY_GRAPH_VERSION || h->endianTag != BINARY_GRAPH_ENDIAN_TAG) {
+        return false;
+    }
+
+    const std::uint64_t V = static_cast<std::uint64_t>(h->vertexCount);
+    const std::uint64_t E = static_cast<std::uint64_t>(h->edgeCount);
+    auto inside = [&](std::uint64_t pos, std::uint64_t bytes) {
+        return pos % SECTION_ALIGN == 0 && pos <= m->size() && bytes <= m->size() - pos;
+    };
+    if (h->vertexCount < 0 || h->edgeCount < 0 || h->fileBytes != m->size() ||
+        V >= 0x7fffffffULL || E >= 0x7fffffffULL ||
+        !inside(h->offsetsPos, (V + 1) * sizeof(int)) ||
+        !inside(h->targetsPos, E * sizeof(int)) ||
+        !inside(h->weightsPos, E * sizeof(int)) ||
+        !inside(h->labelOffsetsPos, (V + 1) * sizeof(std::uint32_t)) ||
+        !inside(h->labelBlobPos, h->labelBlobBytes)) {
+        return false;
+    }
+
+    const int* offsets = reinterpret_cast<const int*>(m->data() + h->offsetsPos);
+    const int* targets = reinterpret_cast<const int*>(m->data() + h->targetsPos);
+    const auto* labels = reinterpret_cast<const std::uint32_t*>(m->data() + h->labelOffsetsPos);
+    if (offsets[0] != 0 || static_cast<std::uint64_t>(offsets[V]) != E ||
+        labels[0] != 0 || labels[V] != h->labelBlobBytes) {
+        return false;
+    }
+
+    // Kiểm tra cấu trúc luôn chạy (không cần verify): offsets/nhãn không giảm và mọi đích < V,
+    // để file hỏng không làm truy vấn hay getVertexLabel đọc ra ngoài vùng nhớ
+    for (std::uint64_t u = 0; u < V; u++) {
+        if (offsets[u] > offsets[u + 1] || labels[u] > labels[u + 1]) return false;
+    }
+    for (std::uint64_t i = 0; i < E; i++) {
+        if (targets[i] < 0 || static_cast<std::uint64_t>(targets[i]) >= V) return false;
+    }
+
+    mapping = m;
+    header = h;
+    labelOffsets = labels;
+    labelBlob = m->data() + h->labelBlobPos;
+    snapshot = CsrGraph(static_cast<int>(V), static_cast<int>(E), offsets, targets,
+                        reinterpret_cast<const int*>(m->data() + h->weightsPos), m);
+
+    if (verify && !verifyChecksum()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void BinaryGraphFile::close() {
+    snapshot = CsrGraph();
+    mapping.reset();
+    header = nullptr;
+    labelOffsets = nullptr;
+    labelBlob = nullptr;
+}
+
+bool BinaryGraphFile::isOpen() const {
+    return header != nullptr;
+}
+
+bool BinaryGraphFile::verifyChecksum() const {
+    if (!isOpen()) return false;
+    std::uint64_t hash = fnv1a(FNV_OFFSET, mapping->data() + sizeof(BinaryGraphHeader),
+                               mapping->size() - sizeof(BinaryGraphHeader));
+    return hash == header->checksum;
+}
+
+std::string BinaryGraphFile::getVertexLabel(int vertex) const {
+    if (!isOpen() || vertex < 0 || vertex >= getVertexCount()) {
+        return "Invalid";
+    }
+    return std::string(labelBlob + labelOffsets[vertex], labelOffsets[vertex + 1] - labelOffsets[vertex]);
+}
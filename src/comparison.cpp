@@ -1,7 +1,139 @@
 #include "../lib/Comparison.h"
+#include "../lib/all_pairs.h"
+#include "../lib/alt_landmarks.h"
+#include "../lib/contraction_hierarchy.h"
+#include "../lib/customizable_ch.h"
+#include "../lib/csr_graph.h"
+#include "../lib/delta_stepping.h"
+#include "../lib/floyd_warshall.h"
+#include "../lib/graph_generator.h"
+#include "../lib/hub_labels.h"
+#include "../lib/potentials.h"
+#include "../lib/priority_queues.h"
+#include "../lib/query_workspace.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <random>
 
-Comparison::Comparison(const Graph& g) : graph(g), algorithms(g) {}
+namespace {
+template <typename Run>
+long long timeUs(Run&& run) {
+    auto start = std::chrono::high_resolution_clock::now();
+    run();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int utf8Len(const std::string& s) {
+    int count = 0;
+    for (unsigned char c : s) {
+        if ((c & 0xC0) != 0x80) {
+            count++;
+        }
+    }
+    return count;
+}
+
+std::string fit(const std::string& s, int width) {
+    if (width <= 0) return std::string();
+    int len = utf8Len(s);
+    if (len == width) return s;
+    if (len < width) return s + std::string(width - len, ' ');
+
+    std::string out;
+    out.reserve(s.size());
+    int count = 0;
+    for (size_t i = 0; i < s.size() && count < width; i++) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if ((c & 0xC0) != 0x80) {
+            if (count >= width) break;
+            count++;
+        }
+        out.push_back(s[i]);
+    }
+    int outLen = utf8Len(out);
+    if (outLen < width) {
+        out += std::string(width - outLen, ' ');
+    }
+    return out;
+}
+
+std::string potentialsLine(int passes, long long us) {
+    return "Tiền xử lý Johnson (Bellman-Ford tính thế năng, " + std::to_string(passes) + " lượt): " +
+           std::to_string(us) + " us, không tính vào các dòng trên";
+}
+} // namespace
+
+Comparison::Comparison(const Graph& g) : graph(g), algorithms(g), hierarchyVersion(0), hierarchyBuildUs(0) {}
+
+// Thời gian Bellman-Ford tính thế năng Johnson trên CSR đã có sẵn. Nếu graph đã lưu thế năng
+// (một lần đo trước đã tính) thì tính lại một bản riêng chỉ để đo, nên mọi lần gọi đều đo cùng một việc
+long long Comparison::measurePotentials() {
+    const CsrGraph& csr = graph.getCsr();
+    if (graph.hasCachedPotentials()) {
+        VertexPotentials measured;
+        return timeUs([&] { measured = computePotentials(csr); });
+    }
+    return timeUs([&] { graph.getPotentials(); });
+}
+
+// Dựng lại khi đồ thị đã bị sửa hoặc tải lại kể từ lần dựng trước
+const ContractionHierarchy& Comparison::contractionHierarchy() {
+    if (!hierarchy || hierarchyVersion != graph.getVersion()) {
+        hierarchy = std::make_shared<ContractionHierarchy>();
+        hierarchyBuildUs = timeUs([&] { hierarchy->build(graph); });
+        hierarchyVersion = graph.getVersion();
+    }
+    return *hierarchy;
+}
+
+std::vector<AlgorithmType> Comparison::registeredEngines() {
+    return {
+        AlgorithmType::DIJKSTRA,
+        AlgorithmType::DIJKSTRA_CSR,
+        AlgorithmType::DIJKSTRA_BINARY_DARY_HEAP,
+        AlgorithmType::DIJKSTRA_DARY_HEAP,
+        AlgorithmType::DIJKSTRA_OCTAL_DARY_HEAP,
+        AlgorithmType::DIJKSTRA_PAIRING_HEAP,
+        AlgorithmType::DIJKSTRA_RADIX_HEAP,
+        AlgorithmType::DIJKSTRA_DIAL,
+        AlgorithmType::ZERO_ONE_BFS,
+        AlgorithmType::DIJKSTRA_AUTO,
+        AlgorithmType::DELTA_STEPPING,
+        AlgorithmType::CONTRACTION_HIERARCHY,
+        AlgorithmType::DIJKSTRA_JOHNSON,
+        AlgorithmType::BELLMAN_FORD,
+        AlgorithmType::BELLMAN_FORD_CSR,
+        AlgorithmType::BELLMAN_FORD_SPFA,
+        AlgorithmType::GOLDBERG_RADZIK
+    };
+}
+
+std::string Comparison::engineName(AlgorithmType type) {
+    switch (type) {
+        case AlgorithmType::DIJKSTRA: return "Dijkstra";
+        case AlgorithmType::BELLMAN_FORD: return "Bellman-Ford";
+        case AlgorithmType::DIJKSTRA_CSR: return "Dijkstra (CSR)";
+        case AlgorithmType::BELLMAN_FORD_CSR: return "Bellman-Ford (CSR)";
+        case AlgorithmType::DIJKSTRA_BINARY_DARY_HEAP: return "Dijkstra (2-ary heap)";
+        case AlgorithmType::DIJKSTRA_DARY_HEAP: return "Dijkstra (4-ary heap)";
+        case AlgorithmType::DIJKSTRA_OCTAL_DARY_HEAP: return "Dijkstra (8-ary heap)";
+        case AlgorithmType::DIJKSTRA_PAIRING_HEAP: return "Dijkstra (pairing)";
+        case AlgorithmType::DIJKSTRA_RADIX_HEAP: return "Dijkstra (radix heap)";
+        case AlgorithmType::DIJKSTRA_DIAL: return "Dial (bucket)";
+        case AlgorithmType::ZERO_ONE_BFS: return "0-1 BFS";
+        case AlgorithmType::DIJKSTRA_AUTO: return "Dijkstra (tự chọn)";
+        case AlgorithmType::DELTA_STEPPING: return "Delta-stepping";
+        case AlgorithmType::CONTRACTION_HIERARCHY: return "CH (PHAST)";
+        case AlgorithmType::DIJKSTRA_JOHNSON: return "Dijkstra (Johnson)";
+        case AlgorithmType::BELLMAN_FORD_SPFA: return "SPFA (SLF+LLL)";
+        case AlgorithmType::GOLDBERG_RADZIK: return "Goldberg-Radzik";
+        default: return "";
+    }
+}
 
 PerformanceMetrics Comparison::measureAlgorithm(int startVertex, AlgorithmType type) {
     PerformanceMetrics metrics;
@@ -11,10 +143,10 @@ PerformanceMetrics Comparison::measureAlgorithm(int startVertex, AlgorithmType t
     if (type == AlgorithmType::DIJKSTRA) {
         metrics.algorithmName = "Dijkstra";
         
-        // kiểm tra trong số âm
+        // trọng số âm: chạy trên trọng số rút gọn theo thế năng đã lưu
         if (graph.hasNegativeWeights()) {
-            metrics.success = false;
-            metrics.executionTimeUs = 0;
+            metrics = measureAlgorithm(startVertex, AlgorithmType::DIJKSTRA_JOHNSON);
+            metrics.algorithmName = "Dijkstra (qua Johnson)";
             return metrics;
         }
 
@@ -40,6 +172,187 @@ PerformanceMetrics Comparison::measureAlgorithm(int startVertex, AlgorithmType t
         metrics.memoryUsageBytes = (V * sizeof(int) * 2) + (E * sizeof(Edge));
         metrics.complexity = V * E;
         metrics.success = result.success && !result.hasNegativeCycle;
+
+    } else if (type == AlgorithmType::DIJKSTRA_CSR) {
+        metrics.algorithmName = engineName(type);
+        if (graph.hasNegativeWeights()) {
+            metrics.success = false;
+            metrics.executionTimeUs = 0;
+            return metrics;
+        }
+
+        // ảnh chụp dựng ngoài vùng đo thời gian, giống như getAdjacencyList() có sẵn
+        const CsrGraph& csr = graph.getCsr();
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] { result = algorithms.dijkstra(csr, startVertex, false); });
+        metrics.distancesCalculated = result.distances.size();
+        metrics.memoryUsageBytes = (V * sizeof(int) * 2) + csr.memoryUsageBytes();
+        metrics.complexity = E * std::log(V);
+        metrics.success = result.success;
+
+    } else if (type == AlgorithmType::BELLMAN_FORD_CSR) {
+        metrics.algorithmName = engineName(type);
+
+        const CsrGraph& csr = graph.getCsr();
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] { result = algorithms.bellmanFord(csr, startVertex, false); });
+        metrics.distancesCalculated = result.distances.size();
+        metrics.memoryUsageBytes = (V * sizeof(int) * 2) + csr.memoryUsageBytes();
+        metrics.complexity = V * E;
+        metrics.success = result.success && !result.hasNegativeCycle;
+
+    } else if (type == AlgorithmType::DIJKSTRA_BINARY_DARY_HEAP || type == AlgorithmType::DIJKSTRA_DARY_HEAP ||
+               type == AlgorithmType::DIJKSTRA_OCTAL_DARY_HEAP || type == AlgorithmType::DIJKSTRA_PAIRING_HEAP ||
+               type == AlgorithmType::DIJKSTRA_RADIX_HEAP) {
+        metrics.algorithmName = engineName(type);
+        if (graph.hasNegativeWeights()) {
+            metrics.success = false;
+            metrics.executionTimeUs = 0;
+            return metrics;
+        }
+
+        PathResult result;
+        long long queueBytes = 0;
+        if (type == AlgorithmType::DIJKSTRA_BINARY_DARY_HEAP) {
+            metrics.executionTimeUs = timeUs([&] { result = algorithms.dijkstraWith<IndexedDaryHeap<2>>(startVertex, false); });
+            queueBytes = V * (sizeof(std::pair<int, int>) + sizeof(int));
+        } else if (type == AlgorithmType::DIJKSTRA_DARY_HEAP) {
+            metrics.executionTimeUs = timeUs([&] { result = algorithms.dijkstraWith<IndexedDaryHeap<4>>(startVertex, false); });
+            queueBytes = V * (sizeof(std::pair<int, int>) + sizeof(int));
+        } else if (type == AlgorithmType::DIJKSTRA_OCTAL_DARY_HEAP) {
+            metrics.executionTimeUs = timeUs([&] { result = algorithms.dijkstraWith<IndexedDaryHeap<8>>(startVertex, false); });
+            queueBytes = V * (sizeof(std::pair<int, int>) + sizeof(int));
+        } else if (type == AlgorithmType::DIJKSTRA_PAIRING_HEAP) {
+            metrics.executionTimeUs = timeUs([&] { result = algorithms.dijkstraWith<PairingHeap>(startVertex, false); });
+            queueBytes = V * (4 * sizeof(int) + sizeof(bool));
+        } else {
+            metrics.executionTimeUs = timeUs([&] { result = algorithms.dijkstraWith<RadixHeap>(startVertex, false); });
+            queueBytes = E * sizeof(std::pair<int, int>);
+        }
+        metrics.distancesCalculated = result.distances.size();
+        metrics.memoryUsageBytes = (V * sizeof(int) * 2) + (E * sizeof(Edge)) + queueBytes;
+        metrics.complexity = (E + V) * std::log(V);
+        metrics.success = result.success;
+
+    } else if (type == AlgorithmType::DIJKSTRA_DIAL || type == AlgorithmType::ZERO_ONE_BFS ||
+               type == AlgorithmType::DIJKSTRA_AUTO) {
+        metrics.algorithmName = engineName(type);
+        if (graph.hasNegativeWeights()) {
+            metrics.success = false;
+            metrics.executionTimeUs = 0;
+            return metrics;
+        }
+
+        int minWeight = 0, maxWeight = 0;
+        graph.getWeightRange(minWeight, maxWeight);
+        AlgorithmType engine = type == AlgorithmType::DIJKSTRA_AUTO ? algorithms.chooseDijkstraEngine() : type;
+
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] {
+            if (type == AlgorithmType::DIJKSTRA_DIAL) {
+                result = algorithms.dialDijkstra(startVertex);
+            } else if (type == AlgorithmType::ZERO_ONE_BFS) {
+                result = algorithms.zeroOneBfs(startVertex);
+            } else {
+                result = algorithms.dijkstraAuto(startVertex);
+            }
+        });
+        metrics.distancesCalculated = result.distances.size();
+        metrics.memoryUsageBytes = (V * sizeof(int) * 2) + (E * sizeof(Edge));
+        if (engine == AlgorithmType::DIJKSTRA_DIAL) {
+            metrics.memoryUsageBytes += (maxWeight + 1) * sizeof(std::vector<int>) + E * sizeof(int);
+            metrics.complexity = V + E + maxWeight;
+        } else if (engine == AlgorithmType::ZERO_ONE_BFS) {
+            metrics.memoryUsageBytes += E * sizeof(int);
+            metrics.complexity = V + E;
+        } else if (engine == AlgorithmType::DIJKSTRA_RADIX_HEAP) {
+            metrics.memoryUsageBytes += E * sizeof(std::pair<int, int>);
+            metrics.complexity = E + V * std::log2(static_cast<double>(maxWeight) + 1);
+        } else {
+            metrics.complexity = E * std::log(V);
+        }
+        metrics.success = result.success;
+
+    } else if (type == AlgorithmType::DELTA_STEPPING) {
+        metrics.algorithmName = engineName(type);
+
+        // tách cạnh nhẹ/nặng là tiền xử lý, không tính vào thời gian truy vấn
+        const CsrGraph& csr = graph.getCsr();
+        DeltaStepping engine(csr);
+        if (!engine.isValid()) {
+            metrics.success = false;
+            metrics.executionTimeUs = 0;
+            return metrics;
+        }
+
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] { result = engine.run(startVertex); });
+        metrics.distancesCalculated = result.distances.size();
+        metrics.memoryUsageBytes = (V * (sizeof(long long) + sizeof(int))) + csr.memoryUsageBytes() +
+                                   (V + 1) * sizeof(int) * 2;
+        metrics.complexity = (V + E) * std::log(V) / engine.getThreadCount();
+        metrics.success = result.success;
+
+    } else if (type == AlgorithmType::CONTRACTION_HIERARCHY) {
+        metrics.algorithmName = engineName(type);
+
+        // co đỉnh là tiền xử lý, chỉ làm một lần cho mỗi Comparison
+        const ContractionHierarchy& ch = contractionHierarchy();
+        if (!ch.isBuilt()) {
+            metrics.success = false;
+            metrics.executionTimeUs = 0;
+            return metrics;
+        }
+
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] { result = ch.run(startVertex); });
+        metrics.distancesCalculated = result.distances.size();
+        metrics.memoryUsageBytes = (V * (sizeof(long long) + sizeof(int) * 2)) + ch.memoryUsageBytes();
+        metrics.complexity = (V + E) * std::log(V);
+        metrics.success = result.success;
+
+    } else if (type == AlgorithmType::DIJKSTRA_JOHNSON) {
+        metrics.algorithmName = engineName(type);
+
+        // Bellman-Ford tính thế năng chỉ chạy một lần cho mỗi phiên bản đồ thị, không tính vào thời gian;
+        // compareEngines đo riêng phần này (measurePotentials) và in thành một dòng tiền xử lý
+        const VertexPotentials& potentials = graph.getPotentials();
+        if (!potentials.isUsable()) {
+            metrics.success = false;
+            metrics.executionTimeUs = 0;
+            return metrics;
+        }
+
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] { result = algorithms.johnsonDijkstra(startVertex, false); });
+        metrics.distancesCalculated = result.distances.size();
+        metrics.memoryUsageBytes = (V * sizeof(int) * 3) + (E * sizeof(Edge));
+        metrics.complexity = E * std::log(V);
+        metrics.success = result.success;
+
+    } else if (type == AlgorithmType::BELLMAN_FORD_SPFA) {
+        metrics.algorithmName = engineName(type);
+
+        const CsrGraph& csr = graph.getCsr();
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] { result = algorithms.spfa(csr, startVertex, SpfaQueue::SLF_LLL); });
+        metrics.distancesCalculated = result.distances.size();
+        // distances, previousVertex, cây tiền tự (next, prev, depth), cờ hàng đợi và hàng đợi
+        metrics.memoryUsageBytes = (V * (sizeof(int) * 6 + 1)) + csr.memoryUsageBytes();
+        metrics.complexity = V * E;
+        metrics.success = result.success && !result.hasNegativeCycle;
+
+    } else if (type == AlgorithmType::GOLDBERG_RADZIK) {
+        metrics.algorithmName = engineName(type);
+
+        const CsrGraph& csr = graph.getCsr();
+        PathResult result;
+        metrics.executionTimeUs = timeUs([&] { result = algorithms.goldbergRadzik(csr, startVertex); });
+        metrics.distancesCalculated = result.distances.size();
+        // distances, previousVertex, B, gốc DFS, hậu thứ tự, ngăn xếp DFS và hai mảng cờ
+        metrics.memoryUsageBytes = (V * (sizeof(int) * 6 + 2)) + csr.memoryUsageBytes();
+        metrics.complexity = V * E;
+        metrics.success = result.success && !result.hasNegativeCycle;
     }
 
     return metrics;
@@ -57,6 +370,12 @@ ComparisonReport Comparison::comparePerformance(int startVertex, AlgorithmType t
     report.logs.push_back("        ========================================");
     report.logs.push_back("Đỉnh bắt đầu: " + std::to_string(startVertex + 1) + "   Số đỉnh (V): " + std::to_string(report.V) + "  Số cạnh (E): " + std::to_string(report.E));
 
+    // trọng số âm: Dijkstra chạy qua Johnson, thế năng đo riêng như trong compareEngines
+    long long potentialsUs = -1;
+    if ((type == AlgorithmType::DIJKSTRA || type == AlgorithmType::BOTH) && graph.hasNegativeWeights()) {
+        potentialsUs = measurePotentials();
+    }
+
     if (type == AlgorithmType::DIJKSTRA || type == AlgorithmType::BOTH) {
         auto metrics = measureAlgorithm(startVertex, AlgorithmType::DIJKSTRA);
         report.metrics.push_back(metrics);
@@ -67,6 +386,16 @@ ComparisonReport Comparison::comparePerformance(int startVertex, AlgorithmType t
         report.metrics.push_back(metrics);
     }
 
+    // các engine khác: một dòng tóm tắt
+    if (type != AlgorithmType::DIJKSTRA && type != AlgorithmType::BELLMAN_FORD && type != AlgorithmType::BOTH) {
+        auto metrics = measureAlgorithm(startVertex, type);
+        report.metrics.push_back(metrics);
+        report.logs.push_back(metrics.algorithmName + ": " +
+                              (metrics.success ? std::to_string(metrics.executionTimeUs) + " us, " : std::string("")) +
+                              std::to_string(metrics.memoryUsageBytes) + " bytes, " +
+                              (metrics.success ? "Thành công" : "Thất bại"));
+    }
+
     if (type == AlgorithmType::BOTH && report.metrics.size() == 2) {
         const auto& d = report.metrics[0];
         const auto& b = report.metrics[1];
@@ -74,40 +403,6 @@ ComparisonReport Comparison::comparePerformance(int startVertex, AlgorithmType t
         const int labelW = 16;
         const int colW = 20;
 
-        auto utf8Len = [](const std::string& s) {
-            int count = 0;
-            for (unsigned char c : s) {
-                if ((c & 0xC0) != 0x80) {
-                    count++;
-                }
-            }
-            return count;
-        };
-
-        auto fit = [&](const std::string& s, int width) {
-            if (width <= 0) return std::string();
-            int len = utf8Len(s);
-            if (len == width) return s;
-            if (len < width) return s + std::string(width - len, ' ');
-
-            std::string out;
-            out.reserve(s.size());
-            int count = 0;
-            for (size_t i = 0; i < s.size() && count < width; i++) {
-                unsigned char c = static_cast<unsigned char>(s[i]);
-                if ((c & 0xC0) != 0x80) {
-                    if (count >= width) break;
-                    count++;
-                }
-                out.push_back(s[i]);
-            }
-            int outLen = utf8Len(out);
-            if (outLen < width) {
-                out += std::string(width - outLen, ' ');
-            }
-            return out;
-        };
-
         auto row = [&](const std::string& label, const std::string& dv, const std::string& bv) {
             return std::string("|") + fit(label, labelW) + "|"
                 + fit(dv, colW) + "|" + fit(bv, colW) + "|";
@@ -126,7 +421,7 @@ ComparisonReport Comparison::comparePerformance(int startVertex, AlgorithmType t
         };
 
         report.logs.push_back(border);
-        report.logs.push_back(row("", "DIJKSTRA", "BELLMAN-FORD"));
+        report.logs.push_back(row("", graph.hasNegativeWeights() ? "DIJKSTRA (JOHNSON)" : "DIJKSTRA", "BELLMAN-FORD"));
         report.logs.push_back(border);
         report.logs.push_back(row("Thời gian chạy", std::to_string(d.executionTimeUs) + " us",
                                   std::to_string(b.executionTimeUs) + " us"));
@@ -137,6 +432,9 @@ ComparisonReport Comparison::comparePerformance(int startVertex, AlgorithmType t
                                   fmtComplexity(b.complexity, "O(V × E)")));
         report.logs.push_back(row("Trạng thái", fmtStatus(d.success), fmtStatus(b.success)));
         report.logs.push_back(border);
+        if (potentialsUs >= 0) {
+            report.logs.push_back(potentialsLine(graph.getPotentials().passes, potentialsUs));
+        }
     }
 
     if (type == AlgorithmType::BOTH && report.metrics.size() == 2) {
@@ -144,14 +442,565 @@ ComparisonReport Comparison::comparePerformance(int startVertex, AlgorithmType t
         auto dijkstraTime = report.metrics[0].executionTimeUs;
         auto bellmanTime  = report.metrics[1].executionTimeUs;
 
-        if (bellmanTime > 0 && dijkstraTime > 0) {
+        if (!report.metrics[0].success || !report.metrics[1].success) {
+            report.logs.push_back("Phát hiện chu trình âm, không có đường đi ngắn nhất. KHÔNG THỂ SO SÁNH.");
+        } else if (bellmanTime > 0 && dijkstraTime > 0) {
             double ratio = static_cast<double>(bellmanTime) / dijkstraTime;
             report.logs.push_back("Bellman-Ford chậm hơn Dijkstra " + std::to_string(ratio) + " lần");
         } else {
-            report.logs.push_back("Phát hiện trọng số âm, không thể thực hiện thuật toán Dijkstra. KHÔNG THỂ SO SÁNH.");
+            // trọng số âm vẫn chạy được Dijkstra (qua Johnson): chỉ còn trường hợp thời gian làm tròn về 0 us
+            report.logs.push_back("Thời gian chạy dưới 1 us, quá nhỏ để so sánh.");
         }
         report.logs.push_back("");
     }
 
     return report;
 }
+
+ComparisonReport Comparison::compareEngines(int startVertex, const std::vector<AlgorithmType>& types, int repeats) {
+    ComparisonReport report;
+    report.startVertex = startVertex;
+    report.V = graph.getVertexCount();
+    report.E = graph.getEdgeCount();
+    if (repeats < 1) repeats = 1;
+
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("                SO SÁNH CÁC ENGINE");
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("Đỉnh bắt đầu: " + std::to_string(startVertex + 1) + "   Số đỉnh (V): " + std::to_string(report.V) + "  Số cạnh (E): " + std::to_string(report.E) + "   Số lần chạy: " + std::to_string(repeats));
+
+    // Các dòng Johnson (và Dijkstra trên trọng số âm) chỉ tính truy vấn: thế năng được đo một lần ở đây
+    bool johnson = false;
+    for (AlgorithmType type : types) {
+        if (type == AlgorithmType::DIJKSTRA_JOHNSON || (type == AlgorithmType::DIJKSTRA && graph.hasNegativeWeights())) {
+            johnson = true;
+        }
+    }
+    long long potentialsUs = johnson ? measurePotentials() : -1;
+
+    for (AlgorithmType type : types) {
+        PerformanceMetrics total = measureAlgorithm(startVertex, type);
+        for (int i = 1; i < repeats && total.success; i++) {
+            total.executionTimeUs += measureAlgorithm(startVertex, type).executionTimeUs;
+        }
+        total.executionTimeUs /= repeats;
+        report.metrics.push_back(total);
+    }
+
+    const int nameW = 22;
+    const int timeW = 14;
+    const int memW = 18;
+    const int speedW = 10;
+    const int statusW = 12;
+
+    auto row = [&](const std::string& a, const std::string& b, const std::string& c,
+                   const std::string& d, const std::string& e) {
+        return "|" + fit(a, nameW) + "|" + fit(b, timeW) + "|" + fit(c, memW) +
+               "|" + fit(d, speedW) + "|" + fit(e, statusW) + "|";
+    };
+    std::string border = "+" + std::string(nameW, '-') + "+" + std::string(timeW, '-') +
+                         "+" + std::string(memW, '-') + "+" + std::string(speedW, '-') +
+                         "+" + std::string(statusW, '-') + "+";
+
+    report.logs.push_back(border);
+    report.logs.push_back(row("Engine", "Thời gian", "Bộ nhớ", "Tăng tốc", "Trạng thái"));
+    report.logs.push_back(border);
+
+    long long baseline = 0;
+    for (const auto& m : report.metrics) {
+        if (m.success && m.executionTimeUs > 0) {
+            baseline = m.executionTimeUs;
+            break;
+        }
+    }
+
+    for (const auto& m : report.metrics) {
+        std::string speedup = "-";
+        if (m.success && baseline > 0) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "x%.2f",
+                          static_cast<double>(baseline) / (m.executionTimeUs > 0 ? m.executionTimeUs : 1));
+            speedup = buf;
+        }
+        report.logs.push_back(row(m.algorithmName,
+                                  m.success ? std::to_string(m.executionTimeUs) + " us" : "-",
+                                  std::to_string(m.memoryUsageBytes) + " bytes",
+                                  speedup,
+                                  m.success ? "Thành công" : "Thất bại"));
+    }
+    report.logs.push_back(border);
+    if (potentialsUs >= 0) {
+        report.logs.push_back(potentialsLine(graph.getPotentials().passes, potentialsUs));
+    }
+    report.logs.push_back("");
+
+    return report;
+}
+
+ComparisonReport Comparison::benchmarkParsers(const std::vector<std::string>& files, int repeats) {
+    ComparisonReport report;
+    if (repeats < 1) repeats = 1;
+
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("                TỐC ĐỘ ĐỌC FILE ĐỒ THỊ");
+    report.logs.push_back("        ========================================");
+
+    const int nameW = 16;
+    const int colW = 18;
+    auto row = [&](const std::string& a, const std::string& b, const std::string& c,
+                   const std::string& d, const std::string& e) {
+        return "|" + fit(a, nameW) + "|" + fit(b, colW) + "|" + fit(c, colW) +
+               "|" + fit(d, colW) + "|" + fit(e, colW) + "|";
+    };
+    std::string border = "+" + std::string(nameW, '-') + "+" + std::string(colW, '-') +
+                         "+" + std::string(colW, '-') + "+" + std::string(colW, '-') +
+                         "+" + std::string(colW, '-') + "+";
+    auto fmt = [](const char* pattern, double value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), pattern, value);
+        return std::string(buf);
+    };
+
+    report.logs.push_back(border);
+    report.logs.push_back(row("File", "Kích thước", "ifstream", "Song song", "Tăng tốc"));
+    report.logs.push_back(border);
+
+    for (const auto& filename : files) {
+        std::error_code ec;
+        auto bytes = std::filesystem::file_size(filename, ec);
+        if (ec) continue;
+        double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+
+        long long sequentialUs = 0;
+        long long parallelUs = 0;
+        bool ok = true;
+        for (int i = 0; i < repeats; i++) {
+            Graph g;
+            bool needCreate = false;
+            sequentialUs += timeUs([&] { ok = g.readFromFileSequential(filename, needCreate) && ok; });
+            parallelUs += timeUs([&] { ok = g.readFromFile(filename, needCreate) && ok; });
+        }
+        if (!ok) continue;
+
+        double seqRate = megabytes / (std::max(1LL, sequentialUs) / 1e6 / repeats);
+        double parRate = megabytes / (std::max(1LL, parallelUs) / 1e6 / repeats);
+        report.logs.push_back(row(std::filesystem::path(filename).filename().string(),
+                                  fmt("%.2f MB", megabytes),
+                                  fmt("%.1f MB/s", seqRate),
+                                  fmt("%.1f MB/s", parRate),
+                                  fmt("x%.2f", parRate / seqRate)));
+    }
+    report.logs.push_back(border);
+    report.logs.push_back("");
+
+    return report;
+}
+
+ComparisonReport Comparison::benchmarkSyntheticParsers(const std::vector<int>& edgeCounts, int repeats) {
+    std::error_code ec;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    std::vector<std::string> files;
+    if (!ec) {
+        for (int edges : edgeCounts) {
+            std::string name = edges % 1000000 == 0 ? std::to_string(edges / 1000000) + "M"
+                             : edges % 1000 == 0  ? std::to_string(edges / 1000) + "K"
+                                                  : std::to_string(edges);
+            std::string filename = (dir / ("random_" + name + ".txt")).string();
+            // đồ thị được giải phóng trước khi đo để hai bộ đọc có cùng bộ nhớ trống
+            Graph generated;
+            generateRandomGraph(generated, std::max(1, edges / 8), edges, 1, 1000);
+            if (generated.saveToFile(filename)) {
+                files.push_back(filename);
+            }
+        }
+    }
+
+    ComparisonReport report = benchmarkParsers(files, repeats);
+    for (const auto& filename : files) {
+        std::filesystem::remove(filename, ec);
+    }
+    return report;
+}
+
+ComparisonReport Comparison::benchmarkThreadScaling(int startVertex, const std::vector<int>& threadCounts, int delta) {
+    ComparisonReport report;
+    report.startVertex = startVertex;
+    report.V = graph.getVertexCount();
+    report.E = graph.getEdgeCount();
+
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("            DELTA-STEPPING THEO SỐ LUỒNG");
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("Đỉnh bắt đầu: " + std::to_string(startVertex + 1) + "   Số đỉnh (V): " + std::to_string(report.V) + "  Số cạnh (E): " + std::to_string(report.E));
+
+    if (graph.hasNegativeWeights()) {
+        report.logs.push_back("Đồ thị có trọng số âm, không chạy được delta-stepping.");
+        return report;
+    }
+
+    const CsrGraph& csr = graph.getCsr();
+    PathResult reference;
+    long long dijkstraUs = timeUs([&] { reference = algorithms.dijkstraWith<IndexedDaryHeap<4>>(csr, startVertex, false); });
+
+    const int colW = 16;
+    auto row = [&](const std::string& a, const std::string& b, const std::string& c, const std::string& d,
+                   const std::string& e) {
+        return "|" + fit(a, colW) + "|" + fit(b, colW) + "|" + fit(c, colW) + "|" + fit(d, colW) +
+               "|" + fit(e, colW) + "|";
+    };
+    std::string border = "+" + std::string(colW, '-') + "+" + std::string(colW, '-') +
+                         "+" + std::string(colW, '-') + "+" + std::string(colW, '-') +
+                         "+" + std::string(colW, '-') + "+";
+    auto ratio = [](long long base, long long value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "x%.2f", static_cast<double>(base) / std::max(1LL, value));
+        return std::string(buf);
+    };
+
+    report.logs.push_back(border);
+    report.logs.push_back(row("Số luồng", "Thời gian", "So với Dijkstra", "Khớp kết quả", "Chốt (min/max)"));
+    report.logs.push_back(border);
+    report.logs.push_back(row("Dijkstra", std::to_string(dijkstraUs) + " us", "x1.00", "-", "-"));
+
+    for (int threads : threadCounts) {
+        DeltaStepping engine(csr, delta, threads);
+        PathResult result;
+        std::vector<int> settled;
+        long long us = timeUs([&] { result = engine.run(startVertex, &settled); });
+        bool same = result.distances == reference.distances;
+        // số đỉnh luồng ít việc nhất / nhiều việc nhất đã chốt
+        std::string balance = "-";
+        if (!settled.empty()) {
+            balance = std::to_string(*std::min_element(settled.begin(), settled.end())) + "/" +
+                      std::to_string(*std::max_element(settled.begin(), settled.end()));
+        }
+        report.logs.push_back(row(std::to_string(engine.getThreadCount()) + " (delta " + std::to_string(engine.getDelta()) + ")",
+                                  std::to_string(us) + " us", ratio(dijkstraUs, us), same ? "Có" : "Không", balance));
+    }
+    report.logs.push_back(border);
+    report.logs.push_back("");
+
+    return report;
+}
+
+ComparisonReport Comparison::benchmarkAllPairs(const std::vector<int>& threadCounts) {
+    ComparisonReport report;
+    report.V = graph.getVertexCount();
+    report.E = graph.getEdgeCount();
+
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("           MỌI CẶP ĐỈNH (APSP) THEO SỐ LUỒNG");
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("Số đỉnh (V): " + std::to_string(report.V) + "  Số cạnh (E): " + std::to_string(report.E));
+
+    if (report.V == 0) return report;
+    const bool negative = graph.hasNegativeWeights();
+    if (negative && !graph.getPotentials().isUsable()) {
+        report.logs.push_back("Đồ thị có chu trình âm, không có ma trận khoảng cách.");
+        return report;
+    }
+
+    // mốc: một nguồn mỗi lần, mỗi lần cấp phát PathResult mới
+    std::vector<int> reference(static_cast<size_t>(report.V) * report.V);
+    long long loopUs = timeUs([&] {
+        for (int s = 0; s < report.V; s++) {
+            PathResult result = negative ? algorithms.johnsonDijkstra(s, false) : algorithms.dijkstra(s, false);
+            std::copy(result.distances.begin(), result.distances.end(), reference.begin() + static_cast<size_t>(s) * report.V);
+        }
+    });
+
+    const int colW = 16;
+    auto row = [&](const std::string& a, const std::string& b, const std::string& c, const std::string& d) {
+        return "|" + fit(a, colW + 8) + "|" + fit(b, colW) + "|" + fit(c, colW) + "|" + fit(d, colW) + "|";
+    };
+    std::string border = "+" + std::string(colW + 8, '-') + "+" + std::string(colW, '-') +
+                         "+" + std::string(colW, '-') + "+" + std::string(colW, '-') + "+";
+    auto ratio = [](long long base, long long value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "x%.2f", static_cast<double>(base) / std::max(1LL, value));
+        return std::string(buf);
+    };
+
+    report.logs.push_back(border);
+    report.logs.push_back(row("Số luồng", "Thời gian", "So với vòng lặp", "Khớp kết quả"));
+    report.logs.push_back(border);
+    report.logs.push_back(row(negative ? "Vòng johnsonDijkstra()" : "Vòng dijkstra()",
+                              std::to_string(loopUs) + " us", "x1.00", "-"));
+
+    long long matrixBytes = 0;
+    for (int threads : threadCounts) {
+        AllPairsShortestPaths apsp(graph);
+        bool ok = false;
+        long long us = timeUs([&] { ok = apsp.run(threads, true); });
+        bool same = ok && apsp.getDistances() == reference;
+        matrixBytes = apsp.memoryUsageBytes();
+        report.logs.push_back(row(std::to_string(threads) + " luồng (có next-hop)", std::to_string(us) + " us",
+                                  ratio(loopUs, us), same ? "Có" : "Không"));
+    }
+
+    // bản ma trận dày: chọn khối trước (đo một lần cho cả chương trình), không tính vào thời gian
+    int tile = BlockedFloydWarshall::autotuneTileSize();
+    BlockedFloydWarshall dense(graph);
+    bool denseOk = false;
+    long long denseUs = timeUs([&] { denseOk = dense.run(tile); });
+    report.logs.push_back(row("FW chia khối B=" + std::to_string(tile) + (BlockedFloydWarshall::usesAvx2() ? " AVX2" : ""),
+                              denseOk ? std::to_string(denseUs) + " us" : "-", denseOk ? ratio(loopUs, denseUs) : "-",
+                              denseOk && dense.getDistances() == reference ? "Có" : "Không"));
+    report.logs.push_back(border);
+    report.logs.push_back("Ma trận khoảng cách + next-hop: " + std::to_string(matrixBytes / 1024) + " KB");
+    report.logs.push_back("");
+
+    return report;
+}
+
+ComparisonReport Comparison::benchmarkPointToPoint(int queryCount, unsigned seed, const AltIndex* alt,
+                                                   bool withHierarchy) {
+    ComparisonReport report;
+    report.V = graph.getVertexCount();
+    report.E = graph.getEdgeCount();
+
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("            TRUY VẤN CẶP ĐỈNH (SOURCE -> TARGET)");
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("Số truy vấn: " + std::to_string(queryCount) + "   Số đỉnh (V): " + std::to_string(report.V) + "  Số cạnh (E): " + std::to_string(report.E));
+
+    if (report.V == 0 || queryCount <= 0) return report;
+    if (graph.hasNegativeWeights()) {
+        report.logs.push_back("Đồ thị có trọng số âm, không chạy được các engine truy vấn cặp đỉnh.");
+        return report;
+    }
+
+    const CsrGraph& forward = graph.getCsr();
+    const CsrGraph& backward = graph.getReverseCsr();
+
+    // tiền xử lý ALT không tính vào thời gian truy vấn
+    AltIndex ownAlt;
+    if (alt == nullptr || !alt->isBuilt()) {
+        long long buildUs = timeUs([&] { ownAlt.build(graph); });
+        alt = &ownAlt;
+        report.logs.push_back("Dựng ALT (" + std::to_string(ownAlt.getLandmarkCount()) + " landmark): " +
+                              std::to_string(buildUs / 1000) + " ms, " +
+                              std::to_string(ownAlt.memoryUsageBytes() / 1024) + " KB");
+    }
+    const ContractionHierarchy* ch = nullptr;
+    if (withHierarchy) {
+        ch = &contractionHierarchy();
+        report.logs.push_back("Dựng CH (" + std::to_string(ch->getShortcutCount()) + " shortcut): " +
+                              std::to_string(hierarchyBuildUs / 1000) + " ms, " +
+                              std::to_string(ch->memoryUsageBytes() / 1024) + " KB");
+    }
+    // CCH: thứ tự chỉ phụ thuộc cấu trúc, tùy biến là phần chạy lại mỗi khi trọng số đổi
+    CustomizableCH cch;
+    if (withHierarchy) {
+        long long prepareUs = timeUs([&] { cch.prepare(graph); });
+        long long customizeUs = timeUs([&] { cch.customize(graph); });
+        report.logs.push_back("Dựng CCH (" + std::to_string(cch.getArcCount()) + " cung, cây khử cao " +
+                              std::to_string(cch.getTreeHeight()) + "): chuẩn bị " +
+                              std::to_string(prepareUs / 1000) + " ms, tùy biến " +
+                              std::to_string(customizeUs / 1000) + " ms, " +
+                              std::to_string(cch.memoryUsageBytes() / 1024) + " KB");
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, report.V - 1);
+    std::vector<std::pair<int, int>> queries(queryCount);
+    for (auto& q : queries) {
+        q = {pick(rng), pick(rng)};
+    }
+
+    struct QueryRow {
+        std::string name;
+        long long totalUs = 0;
+        long long settled = 0;
+        int mismatches = 0;
+    };
+    std::vector<QueryRow> rows(ch ? 7 : 5);
+    rows[0].name = "Dijkstra một nguồn";
+    rows[1].name = "Dijkstra dừng tại đích";
+    rows[2].name = "Dừng đích + workspace";
+    rows[3].name = "Dijkstra hai chiều";
+    rows[4].name = "ALT (A*, " + std::to_string(alt->getLandmarkCount()) + " landmark)";
+    if (ch) {
+        rows[5].name = "Contraction Hierarchies";
+        rows[6].name = "CCH (cây khử)";
+    }
+    // dùng lại qua mọi truy vấn, như một luồng phục vụ truy vấn liên tục
+    QueryWorkspace workspace(report.V);
+
+    const int INF = std::numeric_limits<int>::max();
+    for (const auto& q : queries) {
+        PathResult full;
+        rows[0].totalUs += timeUs([&] { full = algorithms.dijkstra(q.first, false); });
+        rows[0].settled += std::count_if(full.distances.begin(), full.distances.end(), [&](int d) { return d != INF; });
+        int expected = full.distances[q.second] == INF ? -1 : full.distances[q.second];
+
+        TargetQueryResult single;
+        rows[1].totalUs += timeUs([&] { single = algorithms.dijkstraToTargets(forward, q.first, {q.second}); });
+        rows[1].settled += single.settledVertices;
+        if (single.distances[0] != expected) rows[1].mismatches++;
+
+        int reused = 0;
+        rows[2].totalUs += timeUs([&] { reused = algorithms.dijkstra(forward, q.first, workspace, q.second); });
+        rows[2].settled += reused;
+        if ((workspace.isSettled(q.second) ? workspace.distance(q.second) : -1) != expected) rows[2].mismatches++;
+
+        PointToPointResult bi;
+        rows[3].totalUs += timeUs([&] { bi = algorithms.bidirectionalDijkstra(forward, backward, q.first, q.second); });
+        rows[3].settled += bi.settledVertices;
+        if (bi.distance != expected) rows[3].mismatches++;
+
+        PointToPointResult astar;
+        rows[4].totalUs += timeUs([&] { astar = alt->query(forward, q.first, q.second); });
+        rows[4].settled += astar.settledVertices;
+        if (astar.distance != expected) rows[4].mismatches++;
+
+        if (ch) {
+            PointToPointResult upward;
+            rows[5].totalUs += timeUs([&] { upward = ch->pointToPoint(q.first, q.second); });
+            rows[5].settled += upward.settledVertices;
+            if (upward.distance != expected) rows[5].mismatches++;
+
+            PointToPointResult tree;
+            rows[6].totalUs += timeUs([&] { tree = cch.pointToPoint(q.first, q.second); });
+            rows[6].settled += tree.settledVertices;
+            if (tree.distance != expected) rows[6].mismatches++;
+        }
+    }
+
+    const int colW = 16;
+    auto row = [&](const std::string& a, const std::string& b, const std::string& c,
+                   const std::string& d, const std::string& e) {
+        return "|" + fit(a, colW + 8) + "|" + fit(b, colW) + "|" + fit(c, colW) + "|" + fit(d, colW) + "|" + fit(e, colW) + "|";
+    };
+    std::string border = "+" + std::string(colW + 8, '-') + "+" + std::string(colW, '-') + "+" + std::string(colW, '-') +
+                         "+" + std::string(colW, '-') + "+" + std::string(colW, '-') + "+";
+    auto ratio = [](long long base, long long value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "x%.2f", static_cast<double>(base) / std::max(1LL, value));
+        return std::string(buf);
+    };
+
+    report.logs.push_back(border);
+    report.logs.push_back(row("Engine", "TB/truy vấn", "Đỉnh đã chốt TB", "So với Dijkstra", "Sai khác"));
+    report.logs.push_back(border);
+    for (size_t i = 0; i < rows.size(); i++) {
+        report.logs.push_back(row(rows[i].name, std::to_string(rows[i].totalUs / queryCount) + " us",
+                                  std::to_string(rows[i].settled / queryCount),
+                                  ratio(rows[0].totalUs, rows[i].totalUs),
+                                  i == 0 ? "-" : std::to_string(rows[i].mismatches)));
+    }
+    report.logs.push_back(border);
+    report.logs.push_back("");
+
+    return report;
+}
+
+ComparisonReport Comparison::benchmarkHubLabels(int queryCount, unsigned seed, const HubLabels* labels) {
+    ComparisonReport report;
+    report.V = graph.getVertexCount();
+    report.E = graph.getEdgeCount();
+
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("              NHÃN HUB (ORACLE KHOẢNG CÁCH)");
+    report.logs.push_back("        ========================================");
+    report.logs.push_back("Số truy vấn: " + std::to_string(queryCount) + "   Số đỉnh (V): " + std::to_string(report.V) + "  Số cạnh (E): " + std::to_string(report.E));
+
+    if (report.V == 0 || queryCount <= 0) return report;
+    if (graph.hasNegativeWeights()) {
+        report.logs.push_back("Đồ thị có trọng số âm, không dựng được nhãn hub.");
+        return report;
+    }
+
+    HubLabels ownLabels;
+    if (labels == nullptr || !labels->isBuilt()) {
+        long long buildUs = timeUs([&] { ownLabels.build(graph); });
+        labels = &ownLabels;
+        report.logs.push_back("Dựng nhãn hub: " + std::to_string(buildUs / 1000) + " ms");
+    }
+    char summary[128];
+    std::snprintf(summary, sizeof(summary), "Nhãn TB: %.1f mục/đỉnh/chiều, tổng %lld KB%s",
+                  labels->averageLabelSize(), labels->memoryUsageBytes() / 1024,
+                  labels->hasPaths() ? " (có parents)" : "");
+    report.logs.push_back(summary);
+
+    const CsrGraph& forward = graph.getCsr();
+    const CsrGraph& backward = graph.getReverseCsr();
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, report.V - 1);
+    std::vector<std::pair<int, int>> queries(queryCount);
+    for (auto& q : queries) {
+        q = {pick(rng), pick(rng)};
+    }
+
+    // đáp án và thời gian của Dijkstra đo từng truy vấn
+    const int INF = std::numeric_limits<int>::max();
+    std::vector<int> expected(queryCount);
+    long long dijkstraUs = 0;
+    long long bidirectionalUs = 0;
+    for (int i = 0; i < queryCount; i++) {
+        PathResult full;
+        dijkstraUs += timeUs([&] { full = algorithms.dijkstra(queries[i].first, false); });
+        expected[i] = full.distances[queries[i].second] == INF ? -1 : full.distances[queries[i].second];
+        bidirectionalUs += timeUs([&] {
+            algorithms.bidirectionalDijkstra(forward, backward, queries[i].first, queries[i].second);
+        });
+    }
+
+    // một truy vấn nhãn chỉ vài trăm ns, dưới độ phân giải của đồng hồ nên đo cả lô
+    std::vector<int> distances(queryCount);
+    auto batchStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < queryCount; i++) {
+        distances[i] = labels->distance(queries[i].first, queries[i].second);
+    }
+    long long distanceNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - batchStart).count();
+    int distanceMismatches = 0;
+    for (int i = 0; i < queryCount; i++) {
+        if (distances[i] != expected[i]) distanceMismatches++;
+    }
+
+    std::vector<PointToPointResult> results(queryCount);
+    batchStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < queryCount; i++) {
+        results[i] = labels->query(queries[i].first, queries[i].second);
+    }
+    long long queryNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - batchStart).count();
+    int queryMismatches = 0;
+    long long scanned = 0;
+    for (int i = 0; i < queryCount; i++) {
+        if (results[i].distance != expected[i]) queryMismatches++;
+        scanned += results[i].settledVertices;
+    }
+
+    const int colW = 16;
+    auto row = [&](const std::string& a, const std::string& b, const std::string& c,
+                   const std::string& d, const std::string& e) {
+        return "|" + fit(a, colW + 8) + "|" + fit(b, colW) + "|" + fit(c, colW) + "|" + fit(d, colW) + "|" + fit(e, colW) + "|";
+    };
+    std::string border = "+" + std::string(colW + 8, '-') + "+" + std::string(colW, '-') + "+" + std::string(colW, '-') +
+                         "+" + std::string(colW, '-') + "+" + std::string(colW, '-') + "+";
+    auto ratio = [](long long base, long long value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "x%.1f", static_cast<double>(base) / std::max(1LL, value));
+        return std::string(buf);
+    };
+
+    long long dijkstraNs = dijkstraUs * 1000;
+    report.logs.push_back(border);
+    report.logs.push_back(row("Engine", "TB/truy vấn", "Mục nhãn TB", "So với Dijkstra", "Sai khác"));
+    report.logs.push_back(border);
+    report.logs.push_back(row("Dijkstra một nguồn", std::to_string(dijkstraNs / queryCount) + " ns", "-", "x1.0", "-"));
+    report.logs.push_back(row("Dijkstra hai chiều", std::to_string(bidirectionalUs * 1000 / queryCount) + " ns", "-",
+                              ratio(dijkstraNs, bidirectionalUs * 1000), "-"));
+    report.logs.push_back(row("Nhãn hub (khoảng cách)", std::to_string(distanceNs / queryCount) + " ns", "-",
+                              ratio(dijkstraNs, distanceNs), std::to_string(distanceMismatches)));
+    report.logs.push_back(row(labels->hasPaths() ? "Nhãn hub (có đường đi)" : "Nhãn hub (không parents)",
+                              std::to_string(queryNs / queryCount) + " ns", std::to_string(scanned / queryCount),
+                              ratio(dijkstraNs, queryNs), std::to_string(queryMismatches)));
+    report.logs.push_back(border);
+    report.logs.push_back("");
+
+    return report;
+}
@@ -0,0 +1,515 @@
+#include "../lib/contraction_hierarchy.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace {
+const long long UNREACHED = std::numeric_limits<long long>::max();
+// Dijkstra tìm witness dừng sau chừng này đỉnh; thiếu witness chỉ làm thừa shortcut, không sai.
+// Lúc ước lượng độ ưu tiên dùng giới hạn nhỏ hơn vì hàm này được gọi rất nhiều lần.
+const int WITNESS_SETTLE_LIMIT = 500;
+const int PRIORITY_SETTLE_LIMIT = 50;
+
+struct Arc {
+    int to;
+    int weight;
+    int middle;
+};
+
+using Item = std::pair<long long, int>;
+using MinQueue = std::priority_queue<Item, std::vector<Item>, std::greater<Item>>;
+
+// Đồ thị còn lại trong lúc co đỉnh: cung ra/vào của các đỉnh chưa co
+class ContractionGraph {
+public:
+    std::vector<std::vector<Arc>> out;
+    std::vector<std::vector<Arc>> in;
+
+    explicit ContractionGraph(int V) : out(V), in(V), dist(V, UNREACHED), isTarget(V, 0) {}
+
+    // Thêm cung hoặc giảm trọng số nếu đã có cung u -> w
+    void addOrImprove(int u, int w, int weight, int middle) {
+        for (auto& arc : out[u]) {
+            if (arc.to != w) continue;
+            if (weight < arc.weight) {
+                arc.weight = weight;
+                arc.middle = middle;
+                for (auto& back : in[w]) {
+                    if (back.to == u) {
+                        back.weight = weight;
+                        back.middle = middle;
+                        break;
+                    }
+                }
+            }
+            return;
+        }
+        out[u].push_back({w, weight, middle});
+        in[w].push_back({u, weight, middle});
+    }
+
+    // Dijkstra cục bộ từ source bỏ qua đỉnh `skip`, dừng khi vượt limit, đủ số đỉnh
+    // hoặc đã chốt hết `targets` đích đang được đánh dấu (isTarget).
+    // Kết quả đọc bằng distanceTo(); lần gọi sau tự xóa các ô đã chạm.
+    void witnessSearch(int source, int skip, long long limit, int settleLimit, int targets) {
+        for (int v : touched) dist[v] = UNREACHED;
+        touched.clear();
+
+        MinQueue pq;
+        dist[source] = 0;
+        touched.push_back(source);
+        pq.push({0, source});
+        int settled = 0;
+        while (!pq.empty() && settled < settleLimit) {
+            auto [d, u] = pq.top();
+            pq.pop();
+            if (d > dist[u]) continue;
+            if (d > limit) break;
+            settled++;
+            if (isTarget[u] && --targets == 0) break;
+            for (const auto& arc : out[u]) {
+                if (arc.to == skip) continue;
+                long long candidate = d + arc.weight;
+                if (candidate < dist[arc.to]) {
+                    if (dist[arc.to] == UNREACHED) touched.push_back(arc.to);
+                    dist[arc.to] = candidate;
+                    pq.push({candidate, arc.to});
+                }
+            }
+        }
+    }
+
+    long long distanceTo(int v) const { return dist[v]; }
+
+    // Bỏ các cung u -> w mà đã có đường khác ngắn hơn hẳn: cung đó không nằm trên
+    // đường đi ngắn nhất nào nên không cần co qua. Đồ thị dày giảm bậc đáng kể.
+    void dropDominatedArcs(int u) {
+        if (out[u].empty()) return;
+        long long limit = 0;
+        for (const auto& arc : out[u]) {
+            limit = std::max(limit, static_cast<long long>(arc.weight));
+            isTarget[arc.to] = 1;
+        }
+        witnessSearch(u, -1, limit, WITNESS_SETTLE_LIMIT, static_cast<int>(out[u].size()));
+        for (const auto& arc : out[u]) {
+            isTarget[arc.to] = 0;
+            if (distanceTo(arc.to) < arc.weight) {
+                auto& back = in[arc.to];
+                back.erase(std::remove_if(back.begin(), back.end(), [&](const Arc& a) { return a.to == u; }), back.end());
+            }
+        }
+        out[u].erase(std::remove_if(out[u].begin(), out[u].end(),
+                                    [&](const Arc& a) { return distanceTo(a.to) < a.weight; }),
+                     out[u].end());
+    }
+
+    // Số shortcut cần thêm khi co v; nếu shortcuts != nullptr thì ghi lại (u, w, trọng số)
+    int contract(int v, std::vector<std::pair<std::pair<int, int>, int>>* shortcuts) {
+        int count = 0;
+        if (out[v].empty()) return count;
+        for (const auto& outArc : out[v]) {
+            isTarget[outArc.to] = 1;
+        }
+        for (const auto& inArc : in[v]) {
+            const int u = inArc.to;
+            long long limit = 0;
+            for (const auto& outArc : out[v]) {
+                if (outArc.to != u) limit = std::max(limit, static_cast<long long>(inArc.weight) + outArc.weight);
+            }
+            const int targets = static_cast<int>(out[v].size()) - (isTarget[u] ? 1 : 0);
+            if (targets == 0) continue;
+            // u không phải đích của chính nó: tạm bỏ đánh dấu để không đếm nhầm khi chốt u
+            const char sourceMark = isTarget[u];
+            isTarget[u] = 0;
+            witnessSearch(u, v, limit, shortcuts ? WITNESS_SETTLE_LIMIT : PRIORITY_SETTLE_LIMIT, targets);
+            isTarget[u] = sourceMark;
+            for (const auto& outArc : out[v]) {
+                const int w = outArc.to;
+                if (w == u) continue;
+                long long via = static_cast<long long>(inArc.weight) + outArc.weight;
+                if (distanceTo(w) > via) {
+                    count++;
+                    if (shortcuts) shortcuts->push_back({{u, w}, static_cast<int>(via)});
+                }
+            }
+        }
+        for (const auto& outArc : out[v]) {
+            isTarget[outArc.to] = 0;
+        }
+        return count;
+    }
+
+private:
+    std::vector<long long> dist;
+    std::vector<int> touched;
+    std::vector<char> isTarget;
+};
+
+void flatten(const std::vector<std::vector<Arc>>& lists, std::vector<int>& offsets, std::vector<int>& ends,
+             std::vector<int>& weights, std::vector<int>& middles) {
+    const int V = static_cast<int>(lists.size());
+    offsets.assign(V + 1, 0);
+    for (int v = 0; v < V; v++) {
+        offsets[v + 1] = offsets[v] + static_cast<int>(lists[v].size());
+    }
+    ends.resize(offsets[V]);
+    weights.resize(offsets[V]);
+    middles.resize(offsets[V]);
+    for (int v = 0; v < V; v++) {
+        int pos = offsets[v];
+        for (const auto& arc : lists[v]) {
+            ends[pos] = arc.to;
+            weights[pos] = arc.weight;
+            middles[pos] = arc.middle;
+            pos++;
+        }
+    }
+}
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy() : V(0), shortcutCount(0) {}
+
+bool ContractionHierarchy::build(const Graph& graph) {
+    *this = ContractionHierarchy();
+    if (!graph.isValid() || graph.hasNegativeWeights()) return false;
+
+    const int n = graph.getVertexCount();
+    const auto& adjList = graph.getAdjacencyList();
+    ContractionGraph remaining(n);
+    for (int u = 0; u < n; u++) {
+        for (const auto& edge : adjList[u]) {
+            if (edge.destination != u) remaining.addOrImprove(u, edge.destination, edge.weight, -1);
+        }
+    }
+    for (int u = 0; u < n; u++) {
+        remaining.dropDominatedArcs(u);
+    }
+
+    std::vector<int> deletedNeighbors(n, 0);
+    auto priorityOf = [&](int v) {
+        int shortcuts = remaining.contract(v, nullptr);
+        return shortcuts - static_cast<int>(remaining.in[v].size() + remaining.out[v].size()) + deletedNeighbors[v];
+    };
+
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> queue;
+    for (int v = 0; v < n; v++) {
+        queue.push({priorityOf(v), v});
+    }
+
+    rank.assign(n, -1);
+    order.assign(n, -1);
+    std::vector<std::vector<Arc>> upLists(n);
+    std::vector<std::vector<Arc>> downLists(n);
+    std::vector<std::pair<std::pair<int, int>, int>> shortcuts;
+    int nextRank = 0;
+
+    while (!queue.empty()) {
+        int v = queue.top().second;
+        queue.pop();
+        if (rank[v] >= 0) continue;
+
+        // cập nhật lười: độ ưu tiên đã cũ thì tính lại, vẫn không nhỏ nhất thì đẩy lại vào hàng đợi
+        int priority = priorityOf(v);
+        if (!queue.empty() && priority > queue.top().first) {
+            queue.push({priority, v});
+            continue;
+        }
+
+        shortcuts.clear();
+        remaining.contract(v, &shortcuts);
+
+        rank[v] = nextRank;
+        order[nextRank] = v;
+        nextRank++;
+
+        upLists[v] = remaining.out[v];
+        downLists[v] = remaining.in[v];
+        for (const auto& arc : remaining.out[v]) {
+            auto& back = remaining.in[arc.to];
+            back.erase(std::remove_if(back.begin(), back.end(), [&](const Arc& a) { return a.to == v; }), back.end());
+            deletedNeighbors[arc.to]++;
+        }
+        for (const auto& arc : remaining.in[v]) {
+            auto& forward = remaining.out[arc.to];
+            forward.erase(std::remove_if(forward.begin(), forward.end(), [&](const Arc& a) { return a.to == v; }), forward.end());
+            deletedNeighbors[arc.to]++;
+        }
+        remaining.out[v].clear();
+        remaining.in[v].clear();
+
+        for (const auto& shortcut : shortcuts) {
+            remaining.addOrImprove(shortcut.first.first, shortcut.first.second, shortcut.second, v);
+        }
+    }
+
+    flatten(upLists, upOffsets, upTargets, upWeights, upMiddles);
+    flatten(downLists, downOffsets, downSources, downWeights, downMiddles);
+    shortcutCount = static_cast<int>(std::count_if(upMiddles.begin(), upMiddles.end(), [](int m) { return m >= 0; }) +
+                                     std::count_if(downMiddles.begin(), downMiddles.end(), [](int m) { return m >= 0; }));
+    V = n;
+    return true;
+}
+
+long long ContractionHierarchy::memoryUsageBytes() const {
+    long long ints = static_cast<long long>(rank.size() + order.size() +
+                                            upOffsets.size() + upTargets.size() + upWeights.size() + upMiddles.size() +
+                                            downOffsets.size() + downSources.size() + downWeights.size() + downMiddles.size());
+    return ints * static_cast<long long>(sizeof(int));
+}
+
+bool ContractionHierarchy::findArc(int from, int to, int& weight, int& middle) const {
+    if (rank[from] < rank[to]) {
+        for (int i = upOffsets[from]; i < upOffsets[from + 1]; i++) {
+            if (upTargets[i] == to) {
+                weight = upWeights[i];
+                middle = upMiddles[i];
+                return true;
+            }
+        }
+    } else {
+        for (int i = downOffsets[to]; i < downOffsets[to + 1]; i++) {
+            if (downSources[i] == from) {
+                weight = downWeights[i];
+                middle = downMiddles[i];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Thêm các đỉnh sau `from` trên đường gốc của cung from -> to (gồm cả `to`).
+// false nếu có cung không tìm thấy (chỉ mục hỏng); khi đó path không dùng được
+bool ContractionHierarchy::unpackArc(int from, int to, std::vector<int>& path) const {
+    int weight = 0;
+    int middle = -1;
+    if (!findArc(from, to, weight, middle)) {
+        return false;
+    }
+    if (middle < 0) {
+        path.push_back(to);
+        return true;
+    }
+    return unpackArc(from, middle, path) && unpackArc(middle, to, path);
+}
+
+PointToPointResult ContractionHierarchy::pointToPoint(int source, int target) const {
+    PointToPointResult result;
+    if (!isBuilt() || source < 0 || source >= V || target < 0 || target >= V) return result;
+
+    std::vector<long long> dist[2] = {std::vector<long long>(V, UNREACHED), std::vector<long long>(V, UNREACHED)};
+    std::vector<int> parent[2] = {std::vector<int>(V, -1), std::vector<int>(V, -1)};
+    std::vector<char> settled[2] = {std::vector<char>(V, 0), std::vector<char>(V, 0)};
+    MinQueue queues[2];
+
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    queues[0].push({0, source});
+    queues[1].push({0, target});
+
+    long long best = UNREACHED;
+    int meeting = -1;
+
+    while (true) {
+        // mỗi phía dừng khi khóa nhỏ nhất của nó đã >= đường tốt nhất
+        for (int side = 0; side < 2; side++) {
+            if (!queues[side].empty() && queues[side].top().first >= best) {
+                queues[side] = MinQueue();
+            }
+        }
+        if (queues[0].empty() && queues[1].empty()) break;
+
+        int side;
+        if (queues[0].empty()) side = 1;
+        else if (queues[1].empty()) side = 0;
+        else side = queues[0].top().first <= queues[1].top().first ? 0 : 1;
+
+        auto [d, u] = queues[side].top();
+        queues[side].pop();
+        if (settled[side][u]) continue;
+        settled[side][u] = 1;
+        result.settledVertices++;
+
+        if (dist[1 - side][u] != UNREACHED && d + dist[1 - side][u] < best) {
+            best = d + dist[1 - side][u];
+            meeting = u;
+        }
+
+        const std::vector<int>& offsets = side == 0 ? upOffsets : downOffsets;
+        const std::vector<int>& ends = side == 0 ? upTargets : downSources;
+        const std::vector<int>& weights = side == 0 ? upWeights : downWeights;
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = ends[i];
+            long long candidate = d + weights[i];
+            if (candidate < dist[side][v]) {
+                dist[side][v] = candidate;
+                parent[side][v] = u;
+                queues[side].push({candidate, v});
+            }
+        }
+    }
+
+    if (meeting < 0) return result;
+
+    // nửa đầu: các cung đi lên source -> meeting; nửa sau: cung đi xuống meeting -> target
+    std::vector<int> upChain;
+    for (int v = meeting; v != -1; v = parent[0][v]) {
+        upChain.push_back(v);
+    }
+    std::reverse(upChain.begin(), upChain.end());
+
+    result.path.push_back(source);
+    for (size_t i = 0; i + 1 < upChain.size(); i++) {
+        if (!unpackArc(upChain[i], upChain[i + 1], result.path)) {
+            result.path.clear();
+            return result;
+        }
+    }
+    for (int v = meeting; parent[1][v] != -1; v = parent[1][v]) {
+        if (!unpackArc(v, parent[1][v], result.path)) {
+            result.path.clear();
+            return result;
+        }
+    }
+
+    // cung trọng số 0 có thể làm đường đã mở đi qua một đỉnh hai lần; bỏ vòng, độ dài không đổi
+    std::vector<int> position(V, -1);
+    size_t kept = 0;
+    for (size_t i = 0; i < result.path.size(); i++) {
+        int v = result.path[i];
+        if (position[v] >= 0) {
+            for (size_t j = position[v] + 1; j < kept; j++) position[result.path[j]] = -1;
+            kept = position[v] + 1;
+            continue;
+        }
+        position[v] = static_cast<int>(kept);
+        result.path[kept++] = v;
+    }
+    result.path.resize(kept);
+
+    result.found = true;
+    result.distance = static_cast<int>(best);
+    return result;
+}
+
+PathResult ContractionHierarchy::query(int source, int target) const {
+    PathResult result;
+    result.startVertex = source;
+    if (!isBuilt() || source < 0 || source >= V || target < 0 || target >= V) return result;
+
+    const int INF = std::numeric_limits<int>::max();
+    result.distances.assign(V, INF);
+    result.previousVertex.assign(V, -1);
+    result.distances[source] = 0;
+
+    PointToPointResult p2p = pointToPoint(source, target);
+    for (size_t i = 1; i < p2p.path.size(); i++) {
+        int from = p2p.path[i - 1];
+        int to = p2p.path[i];
+        int weight = 0;
+        int middle = -1;
+        if (!findArc(from, to, weight, middle)) {
+            // không có cung thì không biết trọng số: báo thất bại thay vì cộng 0
+            PathResult failed;
+            failed.startVertex = source;
+            return failed;
+        }
+        result.distances[to] = result.distances[from] + weight;
+        result.previousVertex[to] = from;
+    }
+    result.shortestPath = p2p.path;
+    result.success = true;
+    return result;
+}
+
+PathResult ContractionHierarchy::run(int start) const {
+    PathResult result;
+    result.startVertex = start;
+    if (!isBuilt() || start < 0 || start >= V) return result;
+
+    std::vector<long long> dist(V, UNREACHED);
+    std::vector<int> predFrom(V, -1);
+
+    // lượt 1: Dijkstra đầy đủ trên đồ thị đi lên
+    MinQueue pq;
+    dist[start] = 0;
+    pq.push({0, start});
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (d > dist[u]) continue;
+        for (int i = upOffsets[u]; i < upOffsets[u + 1]; i++) {
+            int v = upTargets[i];
+            long long candidate = d + upWeights[i];
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                predFrom[v] = u;
+                pq.push({candidate, v});
+            }
+        }
+    }
+
+    // lượt 2: quét xuống, đỉnh hạng cao đã xong trước khi tới đỉnh hạng thấp hơn
+    for (int r = V - 1; r >= 0; r--) {
+        int v = order[r];
+        for (int i = downOffsets[v]; i < downOffsets[v + 1]; i++) {
+            int u = downSources[i];
+            if (dist[u] == UNREACHED) continue;
+            long long candidate = dist[u] + downWeights[i];
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                predFrom[v] = u;
+            }
+        }
+    }
+
+    const int INF = std::numeric_limits<int>::max();
+    result.distances.assign(V, INF);
+    result.previousVertex.assign(V, -1);
+    for (int v = 0; v < V; v++) {
+        if (dist[v] != UNREACHED) result.distances[v] = static_cast<int>(dist[v]);
+    }
+
+    // Cây predFrom (theo cung CH) không có chu trình. Duyệt từ start xuống, mở từng cung và gán cha
+    // cho các đỉnh chưa có: đỉnh cha luôn được gán trước đỉnh con nên previousVertex cũng không có
+    // chu trình, kể cả khi có vòng trọng số 0 (chọn đỉnh kề cuối của cung thì không bảo đảm được).
+    std::vector<int> childOffsets(V + 1, 0);
+    for (int v = 0; v < V; v++) {
+        if (predFrom[v] >= 0) childOffsets[predFrom[v] + 1]++;
+    }
+    for (int v = 0; v < V; v++) {
+        childOffsets[v + 1] += childOffsets[v];
+    }
+    std::vector<int> children(childOffsets[V]);
+    std::vector<int> fill(childOffsets.begin(), childOffsets.end() - 1);
+    for (int v = 0; v < V; v++) {
+        if (predFrom[v] >= 0) children[fill[predFrom[v]]++] = v;
+    }
+
+    std::vector<char> assigned(V, 0);
+    assigned[start] = 1;
+    std::vector<int> treeOrder = {start};
+    std::vector<int> unpacked;
+    for (size_t i = 0; i < treeOrder.size(); i++) {
+        int u = treeOrder[i];
+        for (int c = childOffsets[u]; c < childOffsets[u + 1]; c++) {
+            int v = children[c];
+            treeOrder.push_back(v);
+            if (assigned[v]) continue;
+            unpacked.assign(1, u);
+            if (!unpackArc(u, v, unpacked)) {
+                PathResult failed;
+                failed.startVertex = start;
+                return failed;
+            }
+            for (size_t k = 1; k < unpacked.size(); k++) {
+                if (assigned[unpacked[k]]) continue;
+                assigned[unpacked[k]] = 1;
+                result.previousVertex[unpacked[k]] = unpacked[k - 1];
+            }
+        }
+    }
+    result.success = true;
+    return result;
+}
@@ -0,0 +1,81 @@
+#include "../lib/csr_graph.h"
+
+namespace {
+const int EMPTY_OFFSETS[1] = {0};
+}
+
+CsrGraph::CsrGraph()
+    : V(0), E(0), offsets(EMPTY_OFFSETS), targets(nullptr), weights(nullptr) {}
+
+CsrGraph::CsrGraph(const Graph& g) : V(g.getVertexCount()), E(0) {
+    const auto& adjList = g.getAdjacencyList();
+    for (int u = 0; u < V; u++) {
+        E += static_cast<int>(adjList[u].size());
+    }
+
+    // một khối liền: offsets | targets | weights
+    auto buffer = std::make_shared<std::vector<int>>(static_cast<size_t>(V) + 1 + 2 * static_cast<size_t>(E));
+    int* offsetsData = buffer->data();
+    int* targetsData = offsetsData + V + 1;
+    int* weightsData = targetsData + E;
+
+    offsetsData[0] = 0;
+    int pos = 0;
+    for (int u = 0; u < V; u++) {
+        for (const auto& edge : adjList[u]) {
+            targetsData[pos] = edge.destination;
+            weightsData[pos] = edge.weight;
+            pos++;
+        }
+        offsetsData[u + 1] = pos;
+    }
+
+    offsets = offsetsData;
+    targets = targetsData;
+    weights = weightsData;
+    storage = buffer;
+}
+
+CsrGraph::CsrGraph(int vertices, int edges, const int* offsetsData, const int* targetsData,
+                   const int* weightsData, std::shared_ptr<const void> owner)
+    : V(vertices), E(edges), offsets(offsetsData), targets(targetsData),
+      weights(weightsData), storage(std::move(owner)) {}
+
+CsrGraph CsrGraph::reversed() const {
+    auto buffer = std::make_shared<std::vector<int>>(static_cast<size_t>(V) + 1 + 2 * static_cast<size_t>(E), 0);
+    int* offsetsData = buffer->data();
+    int* targetsData = offsetsData + V + 1;
+    int* weightsData = targetsData + E;
+
+    for (int i = 0; i < E; i++) {
+        offsetsData[targets[i] + 1]++;
+    }
+    for (int v = 0; v < V; v++) {
+        offsetsData[v + 1] += offsetsData[v];
+    }
+
+    std::vector<int> cursor(offsetsData, offsetsData + V);
+    for (int u = 0; u < V; u++) {
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int pos = cursor[targets[i]]++;
+            targetsData[pos] = u;
+            weightsData[pos] = weights[i];
+        }
+    }
+
+    return CsrGraph(V, E, offsetsData, targetsData, weightsData, buffer);
+}
+
+bool CsrGraph::getWeightRange(int& minWeight, int& maxWeight) const {
+    if (E == 0) return false;
+    minWeight = maxWeight = weights[0];
+    for (int i = 1; i < E; i++) {
+        if (weights[i] < minWeight) minWeight = weights[i];
+        if (weights[i] > maxWeight) maxWeight = weights[i];
+    }
+    return true;
+}
+
+long long CsrGraph::memoryUsageBytes() const {
+    return (static_cast<long long>(V) + 1 + 2 * static_cast<long long>(E)) * sizeof(int);
+}
@@ -0,0 +1,431 @@
+#include "../lib/customizable_ch.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+namespace {
+const int INF = std::numeric_limits<int>::max();
+const long long UNREACHED = std::numeric_limits<long long>::max();
+// Tập đỉnh nhỏ hơn thế này xếp luôn, không tách tiếp
+const int DISSECTION_LEAF_SIZE = 16;
+// Tầng ít đỉnh hơn thế này tùy biến tuần tự, không đáng tạo luồng
+const int PARALLEL_LEVEL_MIN = 64;
+
+struct DissectionTask {
+    std::vector<int> vertices;
+    int lo;                             // các đỉnh nhận thứ hạng [lo, lo + vertices.size())
+};
+
+// Thứ tự nested dissection trên đồ thị vô hướng (CSR). Mỗi tập: nếu không liên thông thì tách
+// theo thành phần; ngược lại BFS từ một đỉnh gần biên, lấy tầng chia đôi số đỉnh làm tập cắt
+// (chỉ giữ đỉnh có láng giềng ở tầng sau), tập cắt nhận các thứ hạng cao nhất của tập.
+std::vector<int> nestedDissection(const std::vector<int>& offsets, const std::vector<int>& targets) {
+    const int V = static_cast<int>(offsets.size()) - 1;
+    std::vector<int> rank(V, -1);
+    std::vector<int> owner(V, 0);
+    std::vector<int> level(V, -1);
+    std::vector<int> queue;
+    int nextOwner = 0;
+
+    std::vector<DissectionTask> stack;
+    DissectionTask all;
+    all.vertices.resize(V);
+    for (int v = 0; v < V; v++) all.vertices[v] = v;
+    all.lo = 0;
+    stack.push_back(std::move(all));
+
+    auto bfs = [&](int root, int id) {
+        queue.assign(1, root);
+        level[root] = 0;
+        for (size_t i = 0; i < queue.size(); i++) {
+            int u = queue[i];
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                int w = targets[e];
+                if (owner[w] == id && level[w] < 0) {
+                    level[w] = level[u] + 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+    };
+
+    while (!stack.empty()) {
+        DissectionTask task = std::move(stack.back());
+        stack.pop_back();
+        const int n = static_cast<int>(task.vertices.size());
+        if (n <= DISSECTION_LEAF_SIZE) {
+            for (int i = 0; i < n; i++) rank[task.vertices[i]] = task.lo + i;
+            continue;
+        }
+
+        const int id = ++nextOwner;
+        for (int v : task.vertices) {
+            owner[v] = id;
+            level[v] = -1;
+        }
+        bfs(task.vertices[0], id);
+
+        if (static_cast<int>(queue.size()) < n) {
+            DissectionTask component{queue, task.lo};
+            DissectionTask rest{{}, task.lo + static_cast<int>(queue.size())};
+            for (int v : task.vertices) {
+                if (level[v] < 0) rest.vertices.push_back(v);
+            }
+            stack.push_back(std::move(component));
+            stack.push_back(std::move(rest));
+            continue;
+        }
+
+        // BFS lại từ đỉnh xa nhất để có nhiều tầng hơn
+        const int farthest = queue.back();
+        for (int v : task.vertices) level[v] = -1;
+        bfs(farthest, id);
+        const int maxLevel = level[queue.back()];
+
+        // queue xếp theo tầng: tầng của đỉnh ở giữa là tầng đầu tiên chứa được nửa số đỉnh
+        const int cut = std::min(level[queue[(n + 1) / 2 - 1]], maxLevel - 1);
+
+        DissectionTask below{{}, task.lo};
+        DissectionTask above;
+        std::vector<int> separator;
+        for (int v : queue) {
+            if (level[v] < cut) {
+                below.vertices.push_back(v);
+            } else if (level[v] > cut) {
+                above.vertices.push_back(v);
+            } else {
+                bool touchesAbove = false;
+                for (int e = offsets[v]; e < offsets[v + 1] && !touchesAbove; e++) {
+                    touchesAbove = owner[targets[e]] == id && level[targets[e]] == cut + 1;
+                }
+                (touchesAbove ? separator : below.vertices).push_back(v);
+            }
+        }
+        above.lo = task.lo + static_cast<int>(below.vertices.size());
+        int top = above.lo + static_cast<int>(above.vertices.size());
+        for (int v : separator) rank[v] = top++;
+        if (!below.vertices.empty()) stack.push_back(std::move(below));
+        if (!above.vertices.empty()) stack.push_back(std::move(above));
+    }
+    return rank;
+}
+
+// Đường đi qua vòng trọng số 0 có thể lặp đỉnh; bỏ vòng, độ dài không đổi
+void eraseLoops(std::vector<int>& path, int V) {
+    std::vector<int> position(V, -1);
+    size_t kept = 0;
+    for (size_t i = 0; i < path.size(); i++) {
+        int v = path[i];
+        if (position[v] >= 0) {
+            for (size_t j = position[v] + 1; j < kept; j++) position[path[j]] = -1;
+            kept = position[v] + 1;
+            continue;
+        }
+        position[v] = static_cast<int>(kept);
+        path[kept++] = v;
+    }
+    path.resize(kept);
+}
+} // namespace
+
+CustomizableCH::CustomizableCH() : V(0), customized(false), treeHeight(0) {}
+
+bool CustomizableCH::prepare(const Graph& graph) {
+    *this = CustomizableCH();
+    if (!graph.isValid()) return false;
+
+    const int n = graph.getVertexCount();
+    const auto& adjList = graph.getAdjacencyList();
+
+    // đồ thị vô hướng đơn, không khuyên
+    std::vector<std::vector<int>> undirected(n);
+    for (int u = 0; u < n; u++) {
+        for (const auto& edge : adjList[u]) {
+            if (edge.destination == u) continue;
+            undirected[u].push_back(edge.destination);
+            undirected[edge.destination].push_back(u);
+        }
+    }
+    std::vector<int> adjOffsets(n + 1, 0);
+    std::vector<int> adjTargets;
+    for (int u = 0; u < n; u++) {
+        auto& list = undirected[u];
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        adjTargets.insert(adjTargets.end(), list.begin(), list.end());
+        adjOffsets[u + 1] = static_cast<int>(adjTargets.size());
+    }
+
+    rank = nestedDissection(adjOffsets, adjTargets);
+    order.assign(n, -1);
+    for (int v = 0; v < n; v++) order[rank[v]] = v;
+
+    // co hình thức theo thứ hạng tăng dần: láng giềng trên của r (trừ cha) gộp vào láng giềng trên của cha
+    std::vector<std::vector<int>> up(n);
+    for (int u = 0; u < n; u++) {
+        for (int e = adjOffsets[u]; e < adjOffsets[u + 1]; e++) {
+            int a = rank[u];
+            int b = rank[adjTargets[e]];
+            if (a < b) up[a].push_back(b);
+        }
+    }
+    for (auto& list : up) {
+        std::sort(list.begin(), list.end());
+    }
+    parent.assign(n, -1);
+    std::vector<int> merged;
+    for (int r = 0; r < n; r++) {
+        if (up[r].empty()) continue;
+        const int p = up[r][0];
+        parent[r] = p;
+        merged.clear();
+        std::set_union(up[p].begin(), up[p].end(), up[r].begin() + 1, up[r].end(), std::back_inserter(merged));
+        up[p].swap(merged);
+    }
+
+    upOffsets.assign(n + 1, 0);
+    for (int r = 0; r < n; r++) {
+        upOffsets[r + 1] = upOffsets[r] + static_cast<int>(up[r].size());
+    }
+    upHeads.reserve(upOffsets[n]);
+    for (int r = 0; r < n; r++) {
+        upHeads.insert(upHeads.end(), up[r].begin(), up[r].end());
+    }
+
+    downOffsets.assign(n + 1, 0);
+    for (int u : upHeads) downOffsets[u + 1]++;
+    for (int r = 0; r < n; r++) downOffsets[r + 1] += downOffsets[r];
+    downTails.resize(upHeads.size());
+    downArcs.resize(upHeads.size());
+    std::vector<int> fill(downOffsets.begin(), downOffsets.end() - 1);
+    for (int r = 0; r < n; r++) {
+        for (int i = upOffsets[r]; i < upOffsets[r + 1]; i++) {
+            int pos = fill[upHeads[i]]++;
+            downTails[pos] = r;
+            downArcs[pos] = i;
+        }
+    }
+
+    // tầng = chiều cao tính từ lá; cha luôn có hạng lớn hơn con nên một lượt tăng dần là đủ
+    std::vector<int> level(n, 0);
+    for (int r = 0; r < n; r++) {
+        if (parent[r] >= 0) level[parent[r]] = std::max(level[parent[r]], level[r] + 1);
+    }
+    treeHeight = n == 0 ? 0 : *std::max_element(level.begin(), level.end()) + 1;
+    levelOffsets.assign(treeHeight + 1, 0);
+    for (int r = 0; r < n; r++) levelOffsets[level[r] + 1]++;
+    for (int l = 0; l < treeHeight; l++) levelOffsets[l + 1] += levelOffsets[l];
+    levelVertices.resize(n);
+    std::vector<int> levelFill(levelOffsets.begin(), levelOffsets.end() - 1);
+    for (int r = 0; r < n; r++) levelVertices[levelFill[level[r]]++] = r;
+
+    V = n;
+    return true;
+}
+
+int CustomizableCH::findArc(int lower, int upper) const {
+    auto first = upHeads.begin() + upOffsets[lower];
+    auto last = upHeads.begin() + upOffsets[lower + 1];
+    auto it = std::lower_bound(first, last, upper);
+    if (it == last || *it != upper) return -1;
+    return static_cast<int>(it - upHeads.begin());
+}
+
+// Xét mọi tam giác dưới (v, u, w) với v < u < w: đường u -> v -> w và w -> v -> u.
+// Chỉ ghi cung của u, chỉ đọc cung của các đỉnh con cháu v (đã xong ở tầng dưới).
+void CustomizableCH::customizeVertex(int u) {
+    for (int d = downOffsets[u]; d < downOffsets[u + 1]; d++) {
+        const int v = downTails[d];
+        const int vu = downArcs[d];
+        const long long vToU = forwardWeights[vu];
+        const long long uToV = backwardWeights[vu];
+        if (vToU == INF && uToV == INF) continue;
+
+        // láng giềng trên của v sau u đều là láng giềng trên của u (đồ thị chordal), cùng thứ tự tăng dần
+        int k = upOffsets[u];
+        for (int j = vu + 1; j < upOffsets[v + 1]; j++) {
+            const int w = upHeads[j];
+            while (upHeads[k] < w) k++;
+            if (uToV != INF && forwardWeights[j] != INF && uToV + forwardWeights[j] < forwardWeights[k]) {
+                forwardWeights[k] = static_cast<int>(uToV + forwardWeights[j]);
+                forwardMiddles[k] = v;
+            }
+            if (vToU != INF && backwardWeights[j] != INF && backwardWeights[j] + vToU < backwardWeights[k]) {
+                backwardWeights[k] = static_cast<int>(backwardWeights[j] + vToU);
+                backwardMiddles[k] = v;
+            }
+        }
+    }
+}
+
+bool CustomizableCH::customize(const Graph& graph, int threads) {
+    customized = false;
+    if (!isPrepared() || graph.getVertexCount() != V || graph.hasNegativeWeights()) return false;
+
+    const size_t arcs = upHeads.size();
+    forwardWeights.assign(arcs, INF);
+    backwardWeights.assign(arcs, INF);
+    forwardMiddles.assign(arcs, -1);
+    backwardMiddles.assign(arcs, -1);
+
+    const auto& adjList = graph.getAdjacencyList();
+    for (int a = 0; a < V; a++) {
+        for (const auto& edge : adjList[a]) {
+            const int ra = rank[a];
+            const int rb = rank[edge.destination];
+            if (ra == rb) continue;
+            const int i = ra < rb ? findArc(ra, rb) : findArc(rb, ra);
+            if (i < 0) return false;
+            int& slot = ra < rb ? forwardWeights[i] : backwardWeights[i];
+            slot = std::min(slot, edge.weight);
+        }
+    }
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int l = 0; l < treeHeight; l++) {
+        const int first = levelOffsets[l];
+        const int count = levelOffsets[l + 1] - first;
+        const int T = std::min(threads, count / PARALLEL_LEVEL_MIN);
+        if (T <= 1) {
+            for (int i = 0; i < count; i++) customizeVertex(levelVertices[first + i]);
+            continue;
+        }
+        std::vector<std::thread> workers;
+        for (int t = 0; t < T; t++) {
+            workers.emplace_back([&, t] {
+                for (int i = t; i < count; i += T) customizeVertex(levelVertices[first + i]);
+            });
+        }
+        for (auto& th : workers) {
+            th.join();
+        }
+    }
+
+    customized = true;
+    return true;
+}
+
+long long CustomizableCH::memoryUsageBytes() const {
+    long long ints = static_cast<long long>(rank.size() + order.size() + parent.size() +
+                                            upOffsets.size() + upHeads.size() +
+                                            downOffsets.size() + downTails.size() + downArcs.size() +
+                                            levelOffsets.size() + levelVertices.size() +
+                                            forwardWeights.size() + backwardWeights.size() +
+                                            forwardMiddles.size() + backwardMiddles.size());
+    return ints * static_cast<long long>(sizeof(int));
+}
+
+// Thêm các thứ hạng sau `from` trên đường gốc của cung from -> to (gồm cả `to`)
+void CustomizableCH::unpackArc(int from, int to, std::vector<int>& path) const {
+    const int i = from < to ? findArc(from, to) : findArc(to, from);
+    const int middle = from < to ? forwardMiddles[i] : backwardMiddles[i];
+    if (middle < 0) {
+        path.push_back(to);
+        return;
+    }
+    unpackArc(from, middle, path);
+    unpackArc(middle, to, path);
+}
+
+PointToPointResult CustomizableCH::pointToPoint(int source, int target) const {
+    PointToPointResult result;
+    if (!customized || source < 0 || source >= V || target < 0 || target >= V) return result;
+
+    const int s = rank[source];
+    const int t = rank[target];
+    std::vector<long long> forwardDist(V, UNREACHED);
+    std::vector<long long> backwardDist(V, UNREACHED);
+    std::vector<int> forwardParent(V, -1);
+    std::vector<int> backwardParent(V, -1);
+
+    // láng giềng trên luôn là tổ tiên trên cây khử, nên duyệt theo chuỗi cha là đủ
+    forwardDist[s] = 0;
+    for (int x = s; x != -1; x = parent[x]) {
+        result.settledVertices++;
+        if (forwardDist[x] == UNREACHED) continue;
+        for (int i = upOffsets[x]; i < upOffsets[x + 1]; i++) {
+            if (forwardWeights[i] == INF) continue;
+            long long candidate = forwardDist[x] + forwardWeights[i];
+            if (candidate < forwardDist[upHeads[i]]) {
+                forwardDist[upHeads[i]] = candidate;
+                forwardParent[upHeads[i]] = x;
+            }
+        }
+    }
+    backwardDist[t] = 0;
+    for (int x = t; x != -1; x = parent[x]) {
+        result.settledVertices++;
+        if (backwardDist[x] == UNREACHED) continue;
+        for (int i = upOffsets[x]; i < upOffsets[x + 1]; i++) {
+            if (backwardWeights[i] == INF) continue;
+            long long candidate = backwardDist[x] + backwardWeights[i];
+            if (candidate < backwardDist[upHeads[i]]) {
+                backwardDist[upHeads[i]] = candidate;
+                backwardParent[upHeads[i]] = x;
+            }
+        }
+    }
+
+    long long best = UNREACHED;
+    int meeting = -1;
+    for (int x = s; x != -1; x = parent[x]) {
+        if (forwardDist[x] == UNREACHED || backwardDist[x] == UNREACHED) continue;
+        if (forwardDist[x] + backwardDist[x] < best) {
+            best = forwardDist[x] + backwardDist[x];
+            meeting = x;
+        }
+    }
+    if (meeting < 0) return result;
+
+    std::vector<int> upChain;
+    for (int x = meeting; x != -1; x = forwardParent[x]) {
+        upChain.push_back(x);
+    }
+    std::reverse(upChain.begin(), upChain.end());
+
+    std::vector<int> ranks = {s};
+    for (size_t i = 0; i + 1 < upChain.size(); i++) {
+        unpackArc(upChain[i], upChain[i + 1], ranks);
+    }
+    for (int x = meeting; backwardParent[x] != -1; x = backwardParent[x]) {
+        unpackArc(x, backwardParent[x], ranks);
+    }
+    eraseLoops(ranks, V);
+
+    result.path.reserve(ranks.size());
+    for (int r : ranks) {
+        result.path.push_back(order[r]);
+    }
+    result.found = true;
+    result.distance = static_cast<int>(best);
+    return result;
+}
+
+PathResult CustomizableCH::query(int source, int target) const {
+    PathResult result;
+    result.startVertex = source;
+    if (!customized || source < 0 || source >= V || target < 0 || target >= V) return result;
+
+    result.distances.assign(V, INF);
+    result.previousVertex.assign(V, -1);
+    result.distances[source] = 0;
+
+    // đường đã mở chỉ gồm cạnh gốc, trọng số đọc từ cung không phải shortcut
+    PointToPointResult p2p = pointToPoint(source, target);
+    for (size_t i = 1; i < p2p.path.size(); i++) {
+        int from = p2p.path[i - 1];
+        int to = p2p.path[i];
+        int a = rank[from];
+        int b = rank[to];
+        int arc = a < b ? findArc(a, b) : findArc(b, a);
+        int weight = a < b ? forwardWeights[arc] : backwardWeights[arc];
+        result.distances[to] = result.distances[from] + weight;
+        result.previousVertex[to] = from;
+    }
+    result.shortestPath = p2p.path;
+    result.success = true;
+    return result;
+}
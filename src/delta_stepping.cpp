@@ -0,0 +1,241 @@
+#include "../lib/delta_stepping.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace {
+const std::uint32_t NO_VALUE = std::numeric_limits<std::uint32_t>::max();
+const long long NO_BUCKET = std::numeric_limits<long long>::max();
+
+std::uint64_t pack(std::uint32_t dist, std::uint32_t pred) {
+    return (static_cast<std::uint64_t>(dist) << 32) | pred;
+}
+
+std::uint32_t distOf(std::uint64_t state) {
+    return static_cast<std::uint32_t>(state >> 32);
+}
+
+class Barrier {
+public:
+    explicit Barrier(int count) : total(count), waiting(0), generation(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        unsigned long long gen = generation;
+        if (++waiting == total) {
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+            return;
+        }
+        cv.wait(lock, [&] { return gen != generation; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    int total;
+    int waiting;
+    unsigned long long generation;
+};
+
+void splitEdges(const CsrGraph& csr, bool light, int delta,
+                std::vector<int>& offsets, std::vector<int>& targets, std::vector<int>& weights) {
+    const int V = csr.getVertexCount();
+    const int* off = csr.getOffsets();
+    const int* tgt = csr.getTargets();
+    const int* wgt = csr.getWeights();
+    offsets.assign(V + 1, 0);
+    for (int u = 0; u < V; u++) {
+        for (int i = off[u]; i < off[u + 1]; i++) {
+            if ((wgt[i] <= delta) == light) {
+                targets.push_back(tgt[i]);
+                weights.push_back(wgt[i]);
+            }
+        }
+        offsets[u + 1] = static_cast<int>(targets.size());
+    }
+}
+} // namespace
+
+DeltaStepping::DeltaStepping(const CsrGraph& csr, int deltaValue, int threads)
+    : V(csr.getVertexCount()), delta(deltaValue), threadCount(threads), maxWeight(0), valid(true) {
+    int minWeight = 0;
+    if (csr.getWeightRange(minWeight, maxWeight) && minWeight < 0) {
+        valid = false;
+        return;
+    }
+
+    if (delta <= 0) {
+        // khoảng max(w) / bậc trung bình: bucket đủ rộng để có việc song song
+        long long E = std::max(1, csr.getEdgeCount());
+        delta = static_cast<int>(std::max(1LL, static_cast<long long>(maxWeight) * V / E));
+    }
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    splitEdges(csr, true, delta, lightOffsets, lightTargets, lightWeights);
+    splitEdges(csr, false, delta, heavyOffsets, heavyTargets, heavyWeights);
+}
+
+PathResult DeltaStepping::run(int start, std::vector<int>* settledPerThread) const {
+    PathResult result;
+    result.startVertex = start;
+    if (!valid || start < 0 || start >= V) {
+        return result;
+    }
+
+    // bucket vòng: từ bucket cur, mọi cạnh chỉ rơi vào [cur, cur + maxWeight / delta + 1]
+    const long long bucketCount = maxWeight / delta + 2;
+    const int T = threadCount;
+
+    std::vector<std::atomic<std::uint64_t>> state(V);
+    std::vector<std::atomic<std::uint32_t>> processed(V);
+    for (int v = 0; v < V; v++) {
+        state[v].store(pack(NO_VALUE, NO_VALUE), std::memory_order_relaxed);
+        processed[v].store(NO_VALUE, std::memory_order_relaxed);
+    }
+    state[start].store(pack(0, NO_VALUE), std::memory_order_relaxed);
+
+    // Đỉnh v thuộc về luồng v % T: chỉ luồng đó giữ v trong bucket và chốt v.
+    // Đỉnh của luồng khác được gửi qua outbox[chủ] và chuyển vào bucket ở lần gộp kế tiếp
+    struct Local {
+        std::vector<std::vector<int>> buckets;
+        std::vector<std::vector<int>> outbox;
+        std::vector<int> frontier;
+        std::vector<int> settled;
+        int settledCount = 0;
+    };
+    std::vector<Local> locals(T);
+    for (auto& local : locals) {
+        local.buckets.resize(static_cast<size_t>(bucketCount));
+        local.outbox.resize(T);
+    }
+    auto slotOf = [&](std::uint32_t dist) {
+        return static_cast<size_t>((dist / delta) % bucketCount);
+    };
+    locals[start % T].buckets[slotOf(0)].push_back(start);
+
+    std::vector<long long> nextBucket(T, NO_BUCKET);
+    std::vector<char> hasMore(T, 0);
+    Barrier barrier(T);
+
+    auto relax = [&](int t, int v, std::uint32_t candidate, int u) {
+        std::uint64_t old = state[v].load(std::memory_order_relaxed);
+        while (candidate < distOf(old)) {
+            if (state[v].compare_exchange_weak(old, pack(candidate, static_cast<std::uint32_t>(u)),
+                                               std::memory_order_relaxed)) {
+                const int owner = v % T;
+                if (owner == t) {
+                    locals[t].buckets[slotOf(candidate)].push_back(v);
+                } else {
+                    locals[t].outbox[owner].push_back(v);
+                }
+                return;
+            }
+        }
+    };
+
+    // Gọi sau barrier: nhận các đỉnh luồng khác gửi tới. Bucket tính theo khoảng cách
+    // hiện tại; nếu v đã giảm tiếp thì lần giảm đó cũng gửi v, bản thừa bị bỏ qua khi xét
+    auto collect = [&](int t) {
+        for (int s = 0; s < T; s++) {
+            auto& inbox = locals[s].outbox[t];
+            for (int v : inbox) {
+                locals[t].buckets[slotOf(distOf(state[v].load(std::memory_order_relaxed)))].push_back(v);
+            }
+            inbox.clear();
+        }
+    };
+
+    auto worker = [&](int t) {
+        Local& local = locals[t];
+        long long cur = 0;
+        while (true) {
+            // bucket khác rỗng nhỏ nhất của luồng này, rồi lấy min trên mọi luồng
+            long long mine = NO_BUCKET;
+            for (long long k = 0; k < bucketCount; k++) {
+                if (!local.buckets[static_cast<size_t>((cur + k) % bucketCount)].empty()) {
+                    mine = cur + k;
+                    break;
+                }
+            }
+            nextBucket[t] = mine;
+            barrier.wait();
+            cur = *std::min_element(nextBucket.begin(), nextBucket.end());
+            barrier.wait();
+            if (cur == NO_BUCKET) break;
+
+            auto& bucket = local.buckets[static_cast<size_t>(cur % bucketCount)];
+            local.settled.clear();
+
+            // pha cạnh nhẹ: lặp tới khi bucket cur rỗng ở mọi luồng
+            while (true) {
+                local.frontier.swap(bucket);
+                for (int u : local.frontier) {
+                    std::uint32_t d = distOf(state[u].load(std::memory_order_relaxed));
+                    if (static_cast<long long>(d / delta) != cur) continue;
+                    if (processed[u].exchange(d, std::memory_order_relaxed) == d) continue;
+                    local.settled.push_back(u);
+                    local.settledCount++;
+                    for (int i = lightOffsets[u]; i < lightOffsets[u + 1]; i++) {
+                        relax(t, lightTargets[i], d + static_cast<std::uint32_t>(lightWeights[i]), u);
+                    }
+                }
+                local.frontier.clear();
+
+                barrier.wait();
+                collect(t);
+                hasMore[t] = bucket.empty() ? 0 : 1;
+                barrier.wait();
+                bool any = std::find(hasMore.begin(), hasMore.end(), 1) != hasMore.end();
+                if (!any) break;
+            }
+
+            // pha cạnh nặng: các đỉnh vừa chốt, mỗi cạnh nới một lần
+            for (int u : local.settled) {
+                std::uint32_t d = distOf(state[u].load(std::memory_order_relaxed));
+                for (int i = heavyOffsets[u]; i < heavyOffsets[u + 1]; i++) {
+                    relax(t, heavyTargets[i], d + static_cast<std::uint32_t>(heavyWeights[i]), u);
+                }
+            }
+            barrier.wait();
+            collect(t);
+            cur++;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < T; t++) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& th : workers) {
+        th.join();
+    }
+
+    if (settledPerThread) {
+        settledPerThread->clear();
+        for (const auto& local : locals) {
+            settledPerThread->push_back(local.settledCount);
+        }
+    }
+
+    const int INF = std::numeric_limits<int>::max();
+    result.distances.assign(V, INF);
+    result.previousVertex.assign(V, -1);
+    for (int v = 0; v < V; v++) {
+        std::uint64_t s = state[v].load(std::memory_order_relaxed);
+        std::uint32_t d = distOf(s);
+        std::uint32_t p = static_cast<std::uint32_t>(s);
+        if (d != NO_VALUE) result.distances[v] = static_cast<int>(d);
+        if (p != NO_VALUE) result.previousVertex[v] = static_cast<int>(p);
+    }
+    result.success = true;
+    return result;
+}
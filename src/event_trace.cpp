@@ -0,0 +1,273 @@
+#include "../lib/event_trace.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+const int INF = std::numeric_limits<int>::max();
+} // namespace
+
+EventTrace::EventTrace(const Graph& g, size_t limit)
+    : graph(g), V(g.getVertexCount()), memoryLimit(limit), snapshotEvery(1),
+      engine(AlgorithmType::DIJKSTRA), totalLines(0), eventCount(0), residentBytes(0),
+      spill(nullptr, std::fclose), cachedChunk(static_cast<size_t>(-1)) {
+    // Một ảnh chụp (V int) không lớn hơn một khối sự kiện
+    const size_t chunkBytes = CHUNK_EVENTS * sizeof(Event);
+    const size_t snapshotBytes = static_cast<size_t>(V) * sizeof(int);
+    snapshotEvery = std::max<size_t>(1, (snapshotBytes + chunkBytes - 1) / chunkBytes);
+    current.assign(V, INF);
+}
+
+// Số dòng StepLogSink sinh ra cho sự kiện, để biết dòng đầu của mỗi khối mà không dựng chữ
+size_t EventTrace::linesOf(const Event& e, AlgorithmType engineAt) const {
+    const bool bellmanFord = engineAt == AlgorithmType::BELLMAN_FORD;
+    switch (e.kind) {
+        case Kind::BEGIN:        return 3;
+        case Kind::ROUND_BEGIN:  return 2;
+        case Kind::SETTLE:       return 3;
+        case Kind::RELAX:        return 1;
+        case Kind::ROUND_END:    return (bellmanFord && !e.flag ? 1 : 0) + 1 + (V > 0 ? 2 : 0);
+        case Kind::CYCLE_CHECK:  return 2;
+        case Kind::CYCLE_EDGE:   return 2;
+        case Kind::FINISH:       return (bellmanFord && !e.flag ? 1 : 0) + 2 + V;
+        case Kind::REWEIGHTED:   return 1;
+        case Kind::SET_DISTANCE: return 0;
+        case Kind::RESTORED:     return 2 + V;
+    }
+    return 0;
+}
+
+void EventTrace::openChunk() {
+    if (residentBytes > memoryLimit) {
+        spillResident();
+    }
+    Chunk chunk;
+    chunk.firstLine = totalLines;
+    chunk.engine = engine;
+    if (chunks.size() % snapshotEvery == 0) {
+        Snapshot snapshot;
+        snapshot.chunk = chunks.size();
+        snapshot.distances = current;
+        residentBytes += current.size() * sizeof(int);
+        snapshots.push_back(std::move(snapshot));
+    }
+    chunk.snapshot = snapshots.size() - 1;
+    chunk.events.reserve(CHUNK_EVENTS);
+    residentBytes += CHUNK_EVENTS * sizeof(Event);
+    chunks.push_back(std::move(chunk));
+}
+
+// Ghi mọi khối đã đầy và mọi ảnh chụp còn trong RAM ra file tạm. Không mở được file thì giữ trong RAM.
+void EventTrace::spillResident() {
+    if (!spill) {
+        spill.reset(std::tmpfile());
+        if (!spill) {
+            memoryLimit = static_cast<size_t>(-1);
+            return;
+        }
+    }
+    std::FILE* file = spill.get();
+    std::fseek(file, 0, SEEK_END);
+    for (Chunk& chunk : chunks) {
+        if (chunk.fileOffset >= 0) continue;
+        chunk.fileOffset = std::ftell(file);
+        std::fwrite(chunk.events.data(), sizeof(Event), chunk.events.size(), file);
+        residentBytes -= chunk.events.capacity() * sizeof(Event);
+        std::vector<Event>().swap(chunk.events);
+    }
+    for (Snapshot& snapshot : snapshots) {
+        if (snapshot.fileOffset >= 0) continue;
+        snapshot.fileOffset = std::ftell(file);
+        std::fwrite(snapshot.distances.data(), sizeof(int), snapshot.distances.size(), file);
+        residentBytes -= snapshot.distances.size() * sizeof(int);
+        std::vector<int>().swap(snapshot.distances);
+    }
+    std::fflush(file);
+}
+
+void EventTrace::record(Kind kind, int a, int b, int c, std::uint8_t flag) {
+    if (chunks.empty() || chunks.back().events.size() == CHUNK_EVENTS) {
+        openChunk();
+    }
+    Event e{kind, flag, 0, a, b, c};
+    if (kind == Kind::BEGIN) {
+        engine = static_cast<AlgorithmType>(flag);
+    }
+    chunks.back().events.push_back(e);
+    totalLines += linesOf(e, engine);
+    eventCount++;
+}
+
+void EventTrace::begin(AlgorithmType type, int start) {
+    current.assign(V, INF);
+    if (start >= 0 && start < V) current[start] = 0;
+    record(Kind::BEGIN, start, 0, 0, static_cast<std::uint8_t>(type));
+}
+
+void EventTrace::beginRound(int round, int totalRounds) {
+    record(Kind::ROUND_BEGIN, round, totalRounds);
+}
+
+void EventTrace::settle(int round, int vertex, int distance) {
+    record(Kind::SETTLE, round, vertex, distance);
+}
+
+void EventTrace::relax(int from, int to, int distance) {
+    current[to] = distance;
+    record(Kind::RELAX, from, to, distance);
+}
+
+// Bảng khoảng cách sau mỗi lượt không được lưu: engine chỉ đổi khoảng cách qua relax()
+void EventTrace::endRound(int round, bool updated, const std::vector<int>& distances) {
+    (void)distances;
+    record(Kind::ROUND_END, round, 0, 0, updated ? 1 : 0);
+}
+
+void EventTrace::beginCycleCheck() {
+    record(Kind::CYCLE_CHECK);
+}
+
+void EventTrace::negativeCycleEdge(int from, int to, int weight) {
+    record(Kind::CYCLE_EDGE, from, to, weight);
+}
+
+void EventTrace::finish(const std::vector<int>& distances, bool hasNegativeCycle) {
+    // Đối chiếu một lần ở cuối; chỉ ghi các đỉnh lệch (thường là không có)
+    for (int v = 0; v < V && v < static_cast<int>(distances.size()); v++) {
+        if (distances[v] != current[v]) {
+            current[v] = distances[v];
+            record(Kind::SET_DISTANCE, v, distances[v]);
+        }
+    }
+    record(Kind::FINISH, 0, 0, 0, hasNegativeCycle ? 1 : 0);
+}
+
+void EventTrace::reweighted(int bellmanFordPasses) {
+    record(Kind::REWEIGHTED, bellmanFordPasses);
+}
+
+// Johnson: chỉ ghi các đỉnh có khoảng cách gốc khác khoảng cách rút gọn
+void EventTrace::restored(const std::vector<int>& distances) {
+    for (int v = 0; v < V && v < static_cast<int>(distances.size()); v++) {
+        if (distances[v] != current[v]) {
+            current[v] = distances[v];
+            record(Kind::SET_DISTANCE, v, distances[v]);
+        }
+    }
+    record(Kind::RESTORED);
+}
+
+const std::vector<EventTrace::Event>& EventTrace::chunkEvents(size_t index) const {
+    const Chunk& chunk = chunks[index];
+    if (chunk.fileOffset < 0) return chunk.events;
+    if (cachedChunk != index) {
+        const size_t count = index + 1 < chunks.size() ? CHUNK_EVENTS
+                                                       : eventCount - CHUNK_EVENTS * index;
+        cachedEvents.resize(count);
+        std::fseek(spill.get(), chunk.fileOffset, SEEK_SET);
+        if (std::fread(cachedEvents.data(), sizeof(Event), count, spill.get()) != count) {
+            cachedEvents.clear();
+        }
+        cachedChunk = index;
+    }
+    return cachedEvents;
+}
+
+std::vector<int> EventTrace::snapshotDistances(size_t index) const {
+    const Snapshot& snapshot = snapshots[index];
+    if (snapshot.fileOffset < 0) return snapshot.distances;
+    std::vector<int> distances(V, INF);
+    std::fseek(spill.get(), snapshot.fileOffset, SEEK_SET);
+    if (std::fread(distances.data(), sizeof(int), distances.size(), spill.get()) != distances.size()) {
+        distances.assign(V, INF);
+    }
+    return distances;
+}
+
+void EventTrace::replay(const Event& e, std::vector<int>& distances, AlgorithmType& engineAt,
+                        StepLogSink* sink) const {
+    switch (e.kind) {
+        case Kind::BEGIN:
+            engineAt = static_cast<AlgorithmType>(e.flag);
+            distances.assign(V, INF);
+            if (e.a >= 0 && e.a < V) distances[e.a] = 0;
+            if (sink) sink->begin(engineAt, e.a);
+            break;
+        case Kind::ROUND_BEGIN:
+            if (sink) sink->beginRound(e.a, e.b);
+            break;
+        case Kind::SETTLE:
+            if (sink) sink->settle(e.a, e.b, e.c);
+            break;
+        case Kind::RELAX:
+            distances[e.b] = e.c;
+            if (sink) sink->relax(e.a, e.b, e.c);
+            break;
+        case Kind::ROUND_END:
+            if (sink) sink->endRound(e.a, e.flag != 0, distances);
+            break;
+        case Kind::CYCLE_CHECK:
+            if (sink) sink->beginCycleCheck();
+            break;
+        case Kind::CYCLE_EDGE:
+            if (sink) sink->negativeCycleEdge(e.a, e.b, e.c);
+            break;
+        case Kind::FINISH:
+            if (sink) sink->finish(distances, e.flag != 0);
+            break;
+        case Kind::REWEIGHTED:
+            if (sink) sink->reweighted(e.a);
+            break;
+        case Kind::SET_DISTANCE:
+            distances[e.a] = e.b;
+            break;
+        case Kind::RESTORED:
+            if (sink) sink->restored(distances);
+            break;
+    }
+}
+
+void EventTrace::lines(size_t first, size_t count, std::vector<std::pair<int, std::string>>& out) const {
+    if (count == 0 || first >= totalLines || chunks.empty()) return;
+    const std::uint64_t last = std::min<std::uint64_t>(totalLines, static_cast<std::uint64_t>(first) + count);
+
+    // Khối cuối cùng bắt đầu không sau dòng first
+    auto it = std::upper_bound(chunks.begin(), chunks.end(), static_cast<std::uint64_t>(first),
+                               [](std::uint64_t line, const Chunk& chunk) { return line < chunk.firstLine; });
+    size_t index = static_cast<size_t>(it - chunks.begin()) - 1;
+
+    // Dựng lại khoảng cách tại đầu khối: ảnh chụp gần nhất rồi phát lại các khối ở giữa
+    const Snapshot& snapshot = snapshots[chunks[index].snapshot];
+    std::vector<int> distances = snapshotDistances(chunks[index].snapshot);
+    AlgorithmType engineAt = chunks[snapshot.chunk].engine;
+    for (size_t c = snapshot.chunk; c < index; c++) {
+        for (const Event& e : chunkEvents(c)) {
+            replay(e, distances, engineAt, nullptr);
+        }
+    }
+    engineAt = chunks[index].engine;
+
+    std::vector<std::pair<int, std::string>> rendered;
+    StepLogSink sink(graph, rendered);
+    std::uint64_t line = chunks[index].firstLine;
+    for (; index < chunks.size() && line < last; index++) {
+        // Giữ bản sao: đọc khối kế tiếp có thể ghi đè khối đệm
+        const std::vector<Event> events = chunkEvents(index);
+        for (const Event& e : events) {
+            if (line >= last) break;
+            const AlgorithmType before = e.kind == Kind::BEGIN ? static_cast<AlgorithmType>(e.flag) : engineAt;
+            const size_t produced = linesOf(e, before);
+            if (line + produced <= first) {
+                // Nằm hoàn toàn trước trang: chỉ cập nhật trạng thái, không dựng chữ
+                replay(e, distances, engineAt, nullptr);
+                line += produced;
+                continue;
+            }
+            rendered.clear();
+            sink.resume(engineAt);
+            replay(e, distances, engineAt, &sink);
+            for (size_t k = 0; k < rendered.size() && line < last; k++, line++) {
+                if (line >= first) out.push_back(std::move(rendered[k]));
+            }
+        }
+    }
+}
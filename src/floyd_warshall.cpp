@@ -0,0 +1,229 @@
+#include "../lib/floyd_warshall.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+// Vô cực trong ma trận làm việc: INF + INF vẫn nằm trong int. Giá trị chặn dưới đối xứng
+// để tổng hai ô bất kỳ cũng không tràn
+const int FW_INF = 0x3FFFFFFF;
+const int FW_NEG_LIMIT = -FW_INF;
+// Số cột xử lý cùng lúc ở pha 3 (4 thanh ghi AVX2); mọi kích thước khối là bội số của nó
+const int TILE_STEP = 32;
+
+// C[i][j] = min(C[i][j], A[i][k] + B[k][j]) cho một khối B x B; k ở vòng ngoài để đúng cả khi
+// A hoặc B chính là C (pha 1 và 2). Clamp: chặn dưới, chỉ cần khi có trọng số âm
+template <bool Clamp>
+void minPlusTile(int* C, const int* A, const int* B, int stride, int tile) {
+#if defined(__AVX2__)
+    const __m256i negLimit = _mm256_set1_epi32(FW_NEG_LIMIT);
+#endif
+    for (int k = 0; k < tile; k++) {
+        const int* bRow = B + static_cast<size_t>(k) * stride;
+        for (int i = 0; i < tile; i++) {
+            const int a = A[static_cast<size_t>(i) * stride + k];
+            if (a >= FW_INF) continue;
+            int* cRow = C + static_cast<size_t>(i) * stride;
+#if defined(__AVX2__)
+            const __m256i va = _mm256_set1_epi32(a);
+            for (int j = 0; j < tile; j += 8) {
+                __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + j)));
+                __m256i best = _mm256_min_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j)), sum);
+                if (Clamp) best = _mm256_max_epi32(best, negLimit);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j), best);
+            }
+#else
+            for (int j = 0; j < tile; j++) {
+                int best = std::min(cRow[j], a + bRow[j]);
+                cRow[j] = Clamp ? std::max(best, FW_NEG_LIMIT) : best;
+            }
+#endif
+        }
+    }
+}
+
+// Pha 3: C không trùng A hay B nên đổi thứ tự thành i-k-j, giữ 32 ô của một dòng C trong thanh ghi
+// suốt vòng k thay vì đọc/ghi lại C ở mỗi k. Giá trị của C không quay lại làm đầu vào nên chỉ cần
+// chặn dưới một lần khi ghi ra
+template <bool Clamp>
+void minPlusTileDisjoint(int* C, const int* A, const int* B, int stride, int tile) {
+    for (int i = 0; i < tile; i++) {
+        int* cRow = C + static_cast<size_t>(i) * stride;
+        const int* aRow = A + static_cast<size_t>(i) * stride;
+        for (int j0 = 0; j0 < tile; j0 += TILE_STEP) {
+#if defined(__AVX2__)
+            __m256i acc0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j0));
+            __m256i acc1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j0 + 8));
+            __m256i acc2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j0 + 16));
+            __m256i acc3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j0 + 24));
+            for (int k = 0; k < tile; k++) {
+                const int a = aRow[k];
+                if (a >= FW_INF) continue;
+                const __m256i va = _mm256_set1_epi32(a);
+                const int* bRow = B + static_cast<size_t>(k) * stride + j0;
+                acc0 = _mm256_min_epi32(acc0, _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow))));
+                acc1 = _mm256_min_epi32(acc1, _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + 8))));
+                acc2 = _mm256_min_epi32(acc2, _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + 16))));
+                acc3 = _mm256_min_epi32(acc3, _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + 24))));
+            }
+            if (Clamp) {
+                const __m256i negLimit = _mm256_set1_epi32(FW_NEG_LIMIT);
+                acc0 = _mm256_max_epi32(acc0, negLimit);
+                acc1 = _mm256_max_epi32(acc1, negLimit);
+                acc2 = _mm256_max_epi32(acc2, negLimit);
+                acc3 = _mm256_max_epi32(acc3, negLimit);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j0), acc0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j0 + 8), acc1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j0 + 16), acc2);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j0 + 24), acc3);
+#else
+            int acc[TILE_STEP];
+            for (int j = 0; j < TILE_STEP; j++) acc[j] = cRow[j0 + j];
+            for (int k = 0; k < tile; k++) {
+                const int a = aRow[k];
+                if (a >= FW_INF) continue;
+                const int* bRow = B + static_cast<size_t>(k) * stride + j0;
+                for (int j = 0; j < TILE_STEP; j++) acc[j] = std::min(acc[j], a + bRow[j]);
+            }
+            for (int j = 0; j < TILE_STEP; j++) cRow[j0 + j] = Clamp ? std::max(acc[j], FW_NEG_LIMIT) : acc[j];
+#endif
+        }
+    }
+}
+
+// Floyd-Warshall chia khối trên ma trận n x n (n chia hết cho tile). false nếu đường chéo âm
+template <bool Clamp>
+bool blockedFloydWarshall(int* d, int n, int tile) {
+    const int blocks = n / tile;
+    auto at = [&](int bi, int bj) { return d + static_cast<size_t>(bi) * tile * n + static_cast<size_t>(bj) * tile; };
+
+    for (int kb = 0; kb < blocks; kb++) {
+        int* diag = at(kb, kb);
+        minPlusTile<Clamp>(diag, diag, diag, n, tile);
+
+        for (int b = 0; b < blocks; b++) {
+            if (b == kb) continue;
+            minPlusTile<Clamp>(at(kb, b), diag, at(kb, b), n, tile);
+            minPlusTile<Clamp>(at(b, kb), at(b, kb), diag, n, tile);
+        }
+
+        for (int bi = 0; bi < blocks; bi++) {
+            if (bi == kb) continue;
+            for (int bj = 0; bj < blocks; bj++) {
+                if (bj == kb) continue;
+                minPlusTileDisjoint<Clamp>(at(bi, bj), at(bi, kb), at(kb, bj), n, tile);
+            }
+        }
+
+        if (Clamp) {
+            for (int v = 0; v < n; v++) {
+                if (d[static_cast<size_t>(v) * n + v] < 0) return false;
+            }
+        }
+    }
+    return true;
+}
+
+int roundUp(int value, int multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+const int AUTOTUNE_SIZE = 384;
+} // namespace
+
+BlockedFloydWarshall::BlockedFloydWarshall(const Graph& g)
+    : graph(g), V(0), tileSize(0), hasNegativeCycle(false) {}
+
+const std::vector<int>& BlockedFloydWarshall::tileCandidates() {
+    static const std::vector<int> candidates = {32, 64, 128, 256};
+    return candidates;
+}
+
+bool BlockedFloydWarshall::usesAvx2() {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+int BlockedFloydWarshall::autotuneTileSize() {
+    // phụ thuộc cache của máy, không phụ thuộc đồ thị: đo một lần cho cả chương trình
+    static const int best = [] {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> weight(1, 1000);
+        std::vector<int> sample(static_cast<size_t>(AUTOTUNE_SIZE) * AUTOTUNE_SIZE);
+        for (int& w : sample) w = rng() % 10 == 0 ? weight(rng) : FW_INF;
+
+        int chosen = tileCandidates().front();
+        long long fastest = std::numeric_limits<long long>::max();
+        for (int tile : tileCandidates()) {
+            std::vector<int> work(sample);
+            auto start = std::chrono::high_resolution_clock::now();
+            blockedFloydWarshall<false>(work.data(), AUTOTUNE_SIZE, tile);
+            long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - start).count();
+            if (us < fastest) {
+                fastest = us;
+                chosen = tile;
+            }
+        }
+        return chosen;
+    }();
+    return best;
+}
+
+bool BlockedFloydWarshall::run(int tile) {
+    V = graph.getVertexCount();
+    hasNegativeCycle = false;
+    distances.clear();
+    if (V == 0) return false;
+
+    // mọi khoảng cách thật phải nhỏ hơn FW_INF / 2 để phân biệt với "không tới được"
+    int minWeight = 0, maxWeight = 0;
+    if (graph.getWeightRange(minWeight, maxWeight)) {
+        long long largest = std::max(std::abs(static_cast<long long>(minWeight)), std::abs(static_cast<long long>(maxWeight)));
+        if (largest * V >= FW_INF / 4) return false;
+    }
+    const bool negative = minWeight < 0;
+
+    tileSize = tile > 0 ? roundUp(tile, TILE_STEP) : autotuneTileSize();
+    const int n = roundUp(V, tileSize);
+    std::vector<int> d(static_cast<size_t>(n) * n, FW_INF);
+    for (int v = 0; v < n; v++) d[static_cast<size_t>(v) * n + v] = 0;
+    const auto& adj = graph.getAdjacencyList();
+    for (int u = 0; u < V; u++) {
+        for (const auto& edge : adj[u]) {
+            int& cell = d[static_cast<size_t>(u) * n + edge.destination];
+            cell = std::min(cell, edge.weight);
+        }
+    }
+
+    bool ok = negative ? blockedFloydWarshall<true>(d.data(), n, tileSize)
+                       : blockedFloydWarshall<false>(d.data(), n, tileSize);
+    if (!ok) {
+        hasNegativeCycle = true;
+        return false;
+    }
+
+    const int INF = std::numeric_limits<int>::max();
+    distances.resize(static_cast<size_t>(V) * V);
+    for (int s = 0; s < V; s++) {
+        const int* src = d.data() + static_cast<size_t>(s) * n;
+        int* dst = distances.data() + static_cast<size_t>(s) * V;
+        for (int t = 0; t < V; t++) {
+            dst[t] = src[t] > FW_INF / 2 ? INF : src[t];
+        }
+    }
+    return true;
+}
+
+long long BlockedFloydWarshall::memoryUsageBytes() const {
+    return static_cast<long long>(distances.capacity()) * sizeof(int);
+}
@@ -1,13 +1,19 @@
 #include "../lib/Graph.h"
+#include "../lib/binary_graph.h"
+#include "../lib/csr_graph.h"
+#include "../lib/graph_text_parser.h"
+#include "../lib/mapped_file.h"
+#include "../lib/potentials.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
-Graph::Graph() : V(0), E(0) {
+Graph::Graph() : V(0), E(0), version(0) {
     std::error_code ec;
     std::filesystem::create_directories(DATA_FOLDER, ec);
 }
 
-Graph::Graph(int vertices) : V(0), E(0) {
+Graph::Graph(int vertices) : V(0), E(0), version(0) {
     std::error_code ec;
     std::filesystem::create_directories(DATA_FOLDER, ec);
     for (int i = 0; i < vertices; i++) {
@@ -27,17 +33,78 @@ int Graph::getEdgeCount() const {
 }
 
 const std::vector<std::vector<Edge>>& Graph::getAdjacencyList() const {
+    ensureAdjacency();
     return adjList;
 }
 
 std::string Graph::getVertexLabel(int vertex) const {
     if (vertex >= 0 && vertex < V) {
-        return vertexLabels[vertex];
+        return mapped ? mapped->getVertexLabel(vertex) : vertexLabels[vertex];
     }
     return "Invalid";
 }
 
+void Graph::ensureAdjacency() const {
+    if (!mapped || static_cast<int>(adjList.size()) == V) {
+        return;
+    }
+    const CsrGraph& file = mapped->csr();
+    const int* offsets = file.getOffsets();
+    const int* targets = file.getTargets();
+    const int* weights = file.getWeights();
+    adjList.assign(V, std::vector<Edge>());
+    for (int u = 0; u < V; u++) {
+        adjList[u].reserve(offsets[u + 1] - offsets[u]);
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            adjList[u].push_back(Edge(targets[i], weights[i]));
+        }
+    }
+}
+
+void Graph::detachMapping() {
+    if (!mapped) {
+        return;
+    }
+    ensureAdjacency();
+    vertexLabels.clear();
+    vertexLabels.reserve(V);
+    for (int v = 0; v < V; v++) {
+        vertexLabels.push_back(mapped->getVertexLabel(v));
+    }
+    mapped.reset();
+}
+
+template <typename Visit>
+void Graph::forEachEdge(Visit&& visit) const {
+    if (mapped) {
+        const CsrGraph& file = mapped->csr();
+        const int* offsets = file.getOffsets();
+        const int* targets = file.getTargets();
+        const int* weights = file.getWeights();
+        for (int u = 0; u < V; u++) {
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                visit(u, targets[i], weights[i]);
+            }
+        }
+        return;
+    }
+    for (int u = 0; u < V; u++) {
+        for (const auto& edge : adjList[u]) {
+            visit(u, edge.destination, edge.weight);
+        }
+    }
+}
+
+void Graph::invalidateCaches() {
+    potentials.reset();
+    csr.reset();
+    reverseCsr.reset();
+    version++;
+}
+
 void Graph::clear() {
+    invalidateCaches();
+    mapped.reset();
     adjList.clear();
     vertexLabels.clear();
     V = 0;
@@ -45,6 +112,8 @@ void Graph::clear() {
 }
 
 void Graph::addVertex(const std::string& label) {
+    detachMapping();
+    invalidateCaches();
     adjList.push_back(std::vector<Edge>());
     vertexLabels.push_back(label);
     V++;
@@ -54,6 +123,8 @@ void Graph::addEdge(int source, int destination, int weight) {
     if (source < 0 || source >= V || destination < 0 || destination >= V) {
         return;
     }
+    detachMapping();
+    invalidateCaches();
 
     for (auto& edge : adjList[source]) {
         if (edge.destination == destination) {
@@ -66,10 +137,84 @@ void Graph::addEdge(int source, int destination, int weight) {
     E++;
 }
 
+// Lượt 1 đếm cạnh mới theo đỉnh nguồn để cấp phát đúng một lần, lượt 2 chép thẳng vào
+// danh sách kề mới (cạnh cũ trước, cạnh mới theo thứ tự xuất hiện), rồi loại trùng tại chỗ
+template <typename ForEachEdge>
+bool Graph::mergeEdges(const ForEachEdge& forEachEdge, DuplicatePolicy policy) {
+    detachMapping();
+    std::vector<int> added(V, 0);
+    forEachEdge([&](int source, int dest, int) {
+        if (source < 0 || source >= V || dest < 0 || dest >= V) return;
+        added[source]++;
+    });
+
+    std::vector<std::vector<Edge>> built(V);
+    for (int u = 0; u < V; u++) {
+        built[u].reserve(adjList[u].size() + added[u]);
+        built[u].insert(built[u].end(), adjList[u].begin(), adjList[u].end());
+    }
+    forEachEdge([&](int source, int dest, int weight) {
+        if (source < 0 || source >= V || dest < 0 || dest >= V) return;
+        built[source].push_back(Edge(dest, weight));
+    });
+
+    // loại trùng: owner[v] == u nghĩa là cạnh u -> v đã có, nằm ở slot[v] trong built[u]
+    std::vector<int> owner(V, -1);
+    std::vector<int> slot(V, 0);
+    int edgeCount = 0;
+    for (int u = 0; u < V; u++) {
+        auto& edges = built[u];
+        size_t kept = 0;
+        for (size_t i = 0; i < edges.size(); i++) {
+            int v = edges[i].destination;
+            if (owner[v] != u) {
+                owner[v] = u;
+                slot[v] = static_cast<int>(kept);
+                edges[kept++] = edges[i];
+                continue;
+            }
+
+            Edge& existing = edges[slot[v]];
+            if (policy == DuplicatePolicy::REJECT) {
+                return false;
+            }
+            if (policy == DuplicatePolicy::KEEP_LAST || edges[i].weight < existing.weight) {
+                existing.weight = edges[i].weight;
+            }
+        }
+        edges.erase(edges.begin() + kept, edges.end());
+        edgeCount += static_cast<int>(kept);
+    }
+
+    invalidateCaches();
+    adjList.swap(built);
+    E = edgeCount;
+    return true;
+}
+
+bool Graph::addEdges(const std::vector<std::tuple<int, int, int>>& edges, DuplicatePolicy policy) {
+    return mergeEdges([&](const auto& visit) {
+        for (const auto& edge : edges) {
+            visit(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
+        }
+    }, policy);
+}
+
 bool Graph::hasEdge(int source, int destination) const {
     if (source < 0 || source >= V) {
         return false;
     }
+    if (mapped) {
+        const CsrGraph& file = mapped->csr();
+        const int* offsets = file.getOffsets();
+        const int* targets = file.getTargets();
+        for (int i = offsets[source]; i < offsets[source + 1]; i++) {
+            if (targets[i] == destination) {
+                return true;
+            }
+        }
+        return false;
+    }
     for (const auto& edge : adjList[source]) {
         if (edge.destination == destination) {
             return true;
@@ -78,12 +223,46 @@ bool Graph::hasEdge(int source, int destination) const {
     return false;
 }
 
+// Thêm cung ngược v -> u (cùng trọng số) cho mọi cạnh u -> v chưa có chiều ngược lại.
+// Cung ngược được gom theo đỉnh đích bằng counting sort nên chạy trong O(V + E),
+// thứ tự và trọng số trùng khớp với cách gọi hasEdge/addEdge lần lượt trước đây.
 void Graph::makeUndirected() {
-    for (int i = 0; i < V; i++) {
-        for (const auto& edge : adjList[i]) {
-            if (!hasEdge(edge.destination, i)) {
-                addEdge(edge.destination, i, edge.weight);
-            }
+    detachMapping();
+    invalidateCaches();
+    std::vector<int> inOffsets(V + 1, 0);
+    for (int u = 0; u < V; u++) {
+        for (const auto& edge : adjList[u]) {
+            inOffsets[edge.destination + 1]++;
+        }
+    }
+    for (int v = 0; v < V; v++) {
+        inOffsets[v + 1] += inOffsets[v];
+    }
+
+    std::vector<int> cursor(inOffsets.begin(), inOffsets.end() - 1);
+    std::vector<int> sources(inOffsets[V]);
+    std::vector<int> weights(inOffsets[V]);
+    for (int u = 0; u < V; u++) {
+        for (const auto& edge : adjList[u]) {
+            int v = edge.destination;
+            sources[cursor[v]] = u;
+            weights[cursor[v]] = edge.weight;
+            cursor[v]++;
+        }
+    }
+
+    // mark[x] == v: cung v -> x đã tồn tại
+    std::vector<int> mark(V, -1);
+    for (int v = 0; v < V; v++) {
+        for (const auto& edge : adjList[v]) {
+            mark[edge.destination] = v;
+        }
+        for (int i = inOffsets[v]; i < inOffsets[v + 1]; i++) {
+            int u = sources[i];
+            if (mark[u] == v) continue;
+            mark[u] = v;
+            adjList[v].push_back(Edge(u, weights[i]));
+            E++;
         }
     }
 }
@@ -100,6 +279,36 @@ bool Graph::readFromFile(const std::string& filename, bool& needCreate) {
         return false;
     }
 
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false;
+    }
+
+    clear();
+
+    ParsedGraphText parsed;
+    bool ok = parseGraphText(file.data(), static_cast<size_t>(file.size()), parsed);
+    for (const auto& label : parsed.labels) {
+        addVertex(label);
+    }
+    if (!ok) {
+        return false;
+    }
+
+    // các bộ đệm của từng luồng được chép thẳng vào danh sách kề, không qua vector tuple
+    mergeEdges([&](const auto& visit) { parsed.forEachEdge(visit); }, DuplicatePolicy::KEEP_LAST);
+    return true;
+}
+
+// Bộ đọc ifstream ban đầu, giữ lại để so sánh tốc độ với parseGraphText
+bool Graph::readFromFileSequential(const std::string& filename, bool& needCreate) {
+    needCreate = false;
+
+    if (!fileExists(filename)) {
+        needCreate = true;
+        return false;
+    }
+
     std::ifstream file(filename);
     if (!file.is_open()) {
         return false;
@@ -125,12 +334,15 @@ bool Graph::readFromFile(const std::string& filename, bool& needCreate) {
         return false;
     }
 
+    std::vector<std::tuple<int, int, int>> edges;
+    edges.reserve(numEdges > 0 ? numEdges : 0);
     for (int i = 0; i < numEdges; i++) {
         int source = 0, dest = 0, weight = 0;
         if (file >> source >> dest >> weight) {
-            addEdge(source - 1, dest - 1, weight);
+            edges.emplace_back(source - 1, dest - 1, weight);
         }
     }
+    addEdges(edges, DuplicatePolicy::KEEP_LAST);
 
     return true;
 }
@@ -142,18 +354,43 @@ bool Graph::saveToFile(const std::string& filename) const {
     }
 
     file << V << "\n";
-    for (const auto& label : vertexLabels) {
-        file << label << " ";
+    for (int v = 0; v < V; v++) {
+        file << getVertexLabel(v) << " ";
     }
     file << "\n";
 
     file << E << "\n";
-    for (int i = 0; i < V; i++) {
-        for (const auto& edge : adjList[i]) {
-            file << (i + 1) << " " << (edge.destination + 1) << " " << edge.weight << "\n";
-        }
+    forEachEdge([&](int u, int v, int weight) {
+        file << (u + 1) << " " << (v + 1) << " " << weight << "\n";
+    });
+
+    return true;
+}
+
+bool Graph::saveToBinaryFile(const std::string& filename) const {
+    return writeBinaryGraph(*this, filename);
+}
+
+bool Graph::readFromBinaryFile(const std::string& filename, bool& needCreate) {
+    needCreate = false;
+    if (!fileExists(filename)) {
+        needCreate = true;
+        return false;
     }
 
+    // open() đã kiểm tra cấu trúc; bỏ checksum để không phải đọc lại toàn bộ file
+    auto file = std::make_shared<BinaryGraphFile>();
+    if (!file->open(filename)) {
+        return false;
+    }
+
+    // Không chép cạnh hay nhãn: truy vấn chạy thẳng trên vùng nhớ đã mmap.
+    // writeBinaryGraph ghi từ adjList nên file không có cạnh trùng
+    clear();
+    V = file->getVertexCount();
+    E = file->getEdgeCount();
+    csr = std::make_shared<const CsrGraph>(file->csr());
+    mapped = file;
     return true;
 }
 
@@ -164,16 +401,14 @@ bool Graph::exportForPython(const std::string& filename) const {
     }
 
     file << V << "\n";
-    for (const auto& label : vertexLabels) {
-        file << label << " ";
+    for (int v = 0; v < V; v++) {
+        file << getVertexLabel(v) << " ";
     }
     file << "\n";
 
-    for (int i = 0; i < V; i++) {
-        for (const auto& edge : adjList[i]) {
-            file << (i + 1) << " " << (edge.destination + 1) << " " << edge.weight << "\n";
-        }
-    }
+    forEachEdge([&](int u, int v, int weight) {
+        file << (u + 1) << " " << (v + 1) << " " << weight << "\n";
+    });
 
     return true;
 }
@@ -185,16 +420,14 @@ bool Graph::exportWithPath(const std::string& filename, const std::vector<int>&
     }
 
     file << V << "\n";
-    for (const auto& label : vertexLabels) {
-        file << label << " ";
+    for (int v = 0; v < V; v++) {
+        file << getVertexLabel(v) << " ";
     }
     file << "\n";
 
-    for (int i = 0; i < V; i++) {
-        for (const auto& edge : adjList[i]) {
-            file << (i + 1) << " " << (edge.destination + 1) << " " << edge.weight << "\n";
-        }
-    }
+    forEachEdge([&](int u, int v, int weight) {
+        file << (u + 1) << " " << (v + 1) << " " << weight << "\n";
+    });
 
     file << "\nPATH:\n";
     for (int v : path) {
@@ -214,6 +447,11 @@ bool Graph::isValid() const {
 }
 
 bool Graph::hasNegativeWeights() const {
+    if (mapped) {
+        const CsrGraph& file = mapped->csr();
+        const int* weights = file.getWeights();
+        return std::any_of(weights, weights + file.getEdgeCount(), [](int w) { return w < 0; });
+    }
     for (int i = 0; i < V; i++) {
         for (const auto& edge : adjList[i]) {
             if (edge.weight < 0) {
@@ -223,3 +461,39 @@ bool Graph::hasNegativeWeights() const {
     }
     return false;
 }
+
+bool Graph::getWeightRange(int& minWeight, int& maxWeight) const {
+    if (mapped) {
+        return mapped->csr().getWeightRange(minWeight, maxWeight);
+    }
+    bool found = false;
+    for (int i = 0; i < V; i++) {
+        for (const auto& edge : adjList[i]) {
+            if (!found || edge.weight < minWeight) minWeight = edge.weight;
+            if (!found || edge.weight > maxWeight) maxWeight = edge.weight;
+            found = true;
+        }
+    }
+    return found;
+}
+
+const VertexPotentials& Graph::getPotentials() const {
+    if (!potentials) {
+        potentials = std::make_shared<const VertexPotentials>(computePotentials(getCsr()));
+    }
+    return *potentials;
+}
+
+const CsrGraph& Graph::getCsr() const {
+    if (!csr) {
+        csr = mapped ? std::make_shared<const CsrGraph>(mapped->csr()) : std::make_shared<const CsrGraph>(*this);
+    }
+    return *csr;
+}
+
+const CsrGraph& Graph::getReverseCsr() const {
+    if (!reverseCsr) {
+        reverseCsr = std::make_shared<const CsrGraph>(getCsr().reversed());
+    }
+    return *reverseCsr;
+}
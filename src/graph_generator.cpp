@@ -0,0 +1,52 @@
+#include "../lib/graph_generator.h"
+#include <random>
+
+void generateRandomGraph(Graph& graph, int vertices, int edges, int minWeight, int maxWeight,
+                         unsigned seed) {
+    graph.clear();
+    for (int i = 0; i < vertices; i++) {
+        graph.addVertex(std::to_string(i + 1));
+    }
+    if (vertices <= 0 || edges <= 0) return;
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    std::uniform_int_distribution<int> weight(minWeight, maxWeight);
+
+    std::vector<std::tuple<int, int, int>> list;
+    list.reserve(edges);
+    for (int i = 0; i < edges; i++) {
+        int u = vertex(rng);
+        int v = vertex(rng);
+        list.emplace_back(u, v, weight(rng));
+    }
+    graph.addEdges(list, DuplicatePolicy::KEEP_LAST);
+}
+
+void generateNegativeWeightGraph(Graph& graph, int vertices, int edges, int minWeight, int maxWeight,
+                                 int potentialRange, unsigned seed) {
+    graph.clear();
+    for (int i = 0; i < vertices; i++) {
+        graph.addVertex(std::to_string(i + 1));
+    }
+    if (vertices <= 0 || edges <= 0) return;
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    std::uniform_int_distribution<int> weight(minWeight, maxWeight);
+    std::uniform_int_distribution<int> potential(0, potentialRange);
+
+    std::vector<int> p(vertices);
+    for (int& value : p) {
+        value = potential(rng);
+    }
+
+    std::vector<std::tuple<int, int, int>> list;
+    list.reserve(edges);
+    for (int i = 0; i < edges; i++) {
+        int u = vertex(rng);
+        int v = vertex(rng);
+        list.emplace_back(u, v, weight(rng) + p[v] - p[u]);
+    }
+    graph.addEdges(list, DuplicatePolicy::KEEP_LAST);
+}
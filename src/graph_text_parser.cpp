@@ -0,0 +1,125 @@
+#include "../lib/graph_text_parser.h"
+#include <algorithm>
+#include <charconv>
+#include <thread>
+
+namespace {
+// khối nhỏ hơn mức này không đáng tạo thêm luồng
+const std::size_t MIN_CHUNK_BYTES = 1 << 20;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+std::size_t skipSpaces(const char* data, std::size_t pos, std::size_t end) {
+    while (pos < end && isSpace(data[pos])) pos++;
+    return pos;
+}
+
+std::size_t tokenEnd(const char* data, std::size_t pos, std::size_t end) {
+    while (pos < end && !isSpace(data[pos])) pos++;
+    return pos;
+}
+
+// Đọc một số nguyên chiếm trọn token [first, last); chấp nhận dấu '+' như operator>>
+bool parseIntToken(const char* first, const char* last, int& value) {
+    if (first != last && *first == '+') {
+        first++;
+        if (first != last && *first == '-') return false;
+    }
+    auto res = std::from_chars(first, last, value);
+    return res.ec == std::errc() && res.ptr == last;
+}
+
+bool readInt(const char* data, std::size_t& pos, std::size_t end, int& value) {
+    pos = skipSpaces(data, pos, end);
+    std::size_t stop = tokenEnd(data, pos, end);
+    if (stop == pos || !parseIntToken(data + pos, data + stop, value)) return false;
+    pos = stop;
+    return true;
+}
+
+struct ChunkResult {
+    std::vector<int> numbers;
+    bool stopped = false;  // gặp token không phải số nguyên
+};
+
+void parseChunk(const char* data, std::size_t begin, std::size_t end, ChunkResult& out) {
+    out.numbers.reserve((end - begin) / 6);
+    std::size_t pos = begin;
+    while (true) {
+        pos = skipSpaces(data, pos, end);
+        if (pos >= end) break;
+        std::size_t stop = tokenEnd(data, pos, end);
+        int value = 0;
+        if (!parseIntToken(data + pos, data + stop, value)) {
+            out.stopped = true;
+            break;
+        }
+        out.numbers.push_back(value);
+        pos = stop;
+    }
+}
+} // namespace
+
+bool parseGraphText(const char* data, std::size_t size, ParsedGraphText& out, int threadCount) {
+    out = ParsedGraphText();
+
+    std::size_t pos = 0;
+    if (!readInt(data, pos, size, out.vertexCount)) {
+        return false;
+    }
+
+    for (int i = 0; i < out.vertexCount; i++) {
+        pos = skipSpaces(data, pos, size);
+        std::size_t stop = tokenEnd(data, pos, size);
+        if (stop == pos) {
+            out.labels.push_back(std::to_string(i + 1));
+        } else {
+            out.labels.emplace_back(data + pos, stop - pos);
+        }
+        pos = stop;
+    }
+
+    if (!readInt(data, pos, size, out.declaredEdges)) {
+        return false;
+    }
+    if (out.declaredEdges <= 0) {
+        return true;
+    }
+
+    // chia phần cạnh thành các khối, mỗi ranh giới dời tới cuối dòng
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    std::size_t body = size - pos;
+    int chunks = static_cast<int>(std::min<std::size_t>(std::max(1, threadCount), body / MIN_CHUNK_BYTES + 1));
+
+    std::vector<std::size_t> bounds(chunks + 1, size);
+    bounds[0] = pos;
+    for (int k = 1; k < chunks; k++) {
+        std::size_t b = std::max(bounds[k - 1], pos + body / chunks * k);
+        while (b < size && data[b] != '\n') b++;
+        bounds[k] = b;
+    }
+
+    std::vector<ChunkResult> results(chunks);
+    std::vector<std::thread> workers;
+    for (int k = 1; k < chunks; k++) {
+        workers.emplace_back(parseChunk, data, bounds[k], bounds[k + 1], std::ref(results[k]));
+    }
+    parseChunk(data, bounds[0], bounds[1], results[0]);
+    for (auto& t : workers) {
+        t.join();
+    }
+
+    // giữ các khối theo thứ tự, bỏ phần sau token hỏng đầu tiên như operator>>
+    std::size_t available = 0;
+    for (auto& r : results) {
+        available += r.numbers.size();
+        out.blocks.push_back(std::move(r.numbers));
+        if (r.stopped) break;
+    }
+    out.edgeCount = std::min<std::size_t>(out.declaredEdges, available / 3);
+    return true;
+}
@@ -1,10 +1,17 @@
 #include "../lib/graphics.h"
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
+#include <conio.h>
+#else
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
 #endif
 
 static int g_graph_result = 0;
@@ -16,6 +23,19 @@ static const int g_virtual_height = 800;
 static const int g_console_cols = 120;
 static const int g_console_rows = 40;
 
+// Khung hình trong bộ nhớ: mỗi ô một ký tự (UTF-8, kèm dấu tổ hợp nếu có) và màu.
+// Các hàm vẽ chỉ ghi vào g_back; swapbuffers() (được getch() gọi trước khi chờ phím)
+// so với g_front - thứ đang hiện trên terminal - và ghi phần khác nhau trong một lần.
+struct Cell {
+    char glyph[8];
+    unsigned char length;
+    unsigned char color;
+};
+
+static std::vector<Cell> g_back;
+static std::vector<Cell> g_front;
+static bool g_front_valid = false;  // false: terminal không còn khớp g_front (lần vẽ đầu, sau std::system, ...)
+
 static void setConsoleUtf8() {
 #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
@@ -87,14 +107,71 @@ static int ansiColorCode(int color) {
     }
 }
 
-static void moveCursor(int row, int col) {
-    if (!g_ansi_enabled) return;
-    std::cout << "\x1b[" << row << ";" << col << "H";
+static Cell blankCell() {
+    Cell cell;
+    cell.glyph[0] = ' ';
+    cell.length = 1;
+    cell.color = 0;
+    return cell;
 }
 
-static void applyColor() {
-    if (!g_ansi_enabled) return;
-    std::cout << "\x1b[" << ansiColorCode(g_current_color) << "m";
+static bool sameCell(const Cell& a, const Cell& b) {
+    return a.length == b.length && a.color == b.color && std::memcmp(a.glyph, b.glyph, a.length) == 0;
+}
+
+static void ensureFrame() {
+    const size_t cells = static_cast<size_t>(g_console_rows) * g_console_cols;
+    if (g_back.size() != cells) {
+        g_back.assign(cells, blankCell());
+        g_front.assign(cells, blankCell());
+        g_front_valid = false;
+    }
+}
+
+// row, col tính từ 1 như escape của terminal; ngoài màn hình thì bỏ qua
+static void putCell(int row, int col, const char* glyph, int length) {
+    if (row < 1 || row > g_console_rows || col < 1 || col > g_console_cols) return;
+    Cell& cell = g_back[static_cast<size_t>(row - 1) * g_console_cols + (col - 1)];
+    if (length > static_cast<int>(sizeof(cell.glyph))) length = static_cast<int>(sizeof(cell.glyph));
+    std::memcpy(cell.glyph, glyph, static_cast<size_t>(length));
+    cell.length = static_cast<unsigned char>(length);
+    // dấu cách trông như nhau với mọi màu chữ
+    cell.color = (length == 1 && glyph[0] == ' ') ? 0 : static_cast<unsigned char>(g_current_color);
+}
+
+static void putText(int row, int col, const char* text) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    while (*p) {
+        int length = 1;
+        if (*p >= 0xF0) length = 4;
+        else if (*p >= 0xE0) length = 3;
+        else if (*p >= 0xC0) length = 2;
+        for (int i = 1; i < length; i++) {
+            if (!p[i]) {
+                length = i;
+                break;
+            }
+        }
+        // dấu tổ hợp U+0300..U+036F (0xCC 0x80 .. 0xCD 0xAF) nằm chung ô với ký tự trước
+        bool combining = length == 2 && (p[0] == 0xCC || (p[0] == 0xCD && p[1] <= 0xAF));
+        if (combining && col > 1 && row >= 1 && row <= g_console_rows && col - 1 <= g_console_cols) {
+            Cell& prev = g_back[static_cast<size_t>(row - 1) * g_console_cols + (col - 2)];
+            if (prev.length + length <= static_cast<int>(sizeof(prev.glyph))) {
+                std::memcpy(prev.glyph + prev.length, p, static_cast<size_t>(length));
+                prev.length = static_cast<unsigned char>(prev.length + length);
+            }
+        } else {
+            putCell(row, col, reinterpret_cast<const char*>(p), length);
+            col++;
+        }
+        p += length;
+    }
+}
+
+static void putRun(int row, int col, char glyph, int count) {
+    for (int i = 0; i < count; i++) {
+        putCell(row, col + i, &glyph, 1);
+    }
 }
 
 static bool writeUtf8(const char* text) {
@@ -119,6 +196,84 @@ static bool writeUtf8(const char* text) {
 #endif
 }
 
+// Ghi cả luồng escape của một khung hình bằng một lần gọi hệ thống
+static void writeFrame(const std::string& frame) {
+    if (frame.empty()) return;
+    std::cout << std::flush;
+#ifdef _WIN32
+    if (writeUtf8(frame.c_str())) return;
+    std::cout << frame << std::flush;
+#else
+    size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t n = ::write(STDOUT_FILENO, frame.data() + written, frame.size() - written);
+        if (n <= 0) {
+            std::cout << frame.substr(written) << std::flush;
+            return;
+        }
+        written += static_cast<size_t>(n);
+    }
+#endif
+}
+
+// So g_back với g_front: chỉ dời con trỏ khi ô cần ghi không nằm ngay sau ô vừa ghi
+// (khoảng trống ngắn thì ghi lại luôn các ô không đổi), chỉ đổi màu khi màu khác màu đang dùng.
+void swapbuffers() {
+    if (!g_ansi_enabled) return;
+    ensureFrame();
+
+    std::string frame;
+    if (!g_front_valid) {
+        frame += "\x1b[0m\x1b[2J";
+        g_front.assign(g_front.size(), blankCell());
+        g_front_valid = true;
+    }
+
+    const int shortGap = 4;
+    int cursorRow = -1;
+    int cursorCol = -1;
+    int color = -1;
+    char escape[32];
+    for (int row = 1; row <= g_console_rows; row++) {
+        const size_t base = static_cast<size_t>(row - 1) * g_console_cols;
+        int col = 1;
+        while (col <= g_console_cols) {
+            if (sameCell(g_back[base + col - 1], g_front[base + col - 1])) {
+                col++;
+                continue;
+            }
+            if (cursorRow == row && cursorCol < col && col - cursorCol <= shortGap) {
+                col = cursorCol;
+            } else if (cursorRow != row || cursorCol != col) {
+                std::snprintf(escape, sizeof(escape), "\x1b[%d;%dH", row, col);
+                frame += escape;
+            }
+            // ghi tới hết đoạn thay đổi (cùng các khoảng trống ngắn bên trong)
+            int lastChanged = col;
+            for (; col <= g_console_cols; col++) {
+                const Cell& cell = g_back[base + col - 1];
+                if (sameCell(cell, g_front[base + col - 1])) {
+                    if (col - lastChanged > shortGap) break;
+                } else {
+                    lastChanged = col;
+                }
+                bool blank = cell.length == 1 && cell.glyph[0] == ' ';
+                if (!blank && cell.color != color) {
+                    color = cell.color;
+                    std::snprintf(escape, sizeof(escape), "\x1b[%dm", ansiColorCode(color));
+                    frame += escape;
+                }
+                frame.append(cell.glyph, cell.length);
+                g_front[base + col - 1] = cell;
+            }
+            // các ô không đổi ở cuối đoạn đã ghi lại cũng không sao; con trỏ nằm sau ô cuối cùng
+            cursorRow = row;
+            cursorCol = col;
+        }
+    }
+    writeFrame(frame);
+}
+
 void initgraph(int *graphdriver, int *graphmode, char *pathtodriver) {
     (void)graphdriver; (void)graphmode; (void)pathtodriver;
     g_graph_result = 0; // grOk
@@ -132,13 +287,15 @@ int graphresult() {
 
 void closegraph() {
     if (g_ansi_enabled) {
-        std::cout << "\x1b[0m" << std::flush;
+        swapbuffers();
+        writeFrame("\x1b[0m");
     }
 }
 
 void cleardevice() {
     if (g_ansi_enabled) {
-        std::cout << "\x1b[2J\x1b[H" << std::flush;
+        ensureFrame();
+        g_back.assign(g_back.size(), blankCell());
     } else {
         std::cout << std::string(50, '\n');
     }
@@ -153,14 +310,8 @@ void setbkcolor(int color) { (void)color; }
 void outtextxy(int x, int y, char *textstring) {
     if (!textstring) return;
     if (g_ansi_enabled) {
-        int row = mapY(y);
-        int col = mapX(x);
-        moveCursor(row, col);
-        applyColor();
-        if (!writeUtf8(textstring)) {
-            std::cout << textstring;
-        }
-        std::cout << std::flush;
+        ensureFrame();
+        putText(mapY(y), mapX(x), textstring);
     } else {
         if (!writeUtf8(textstring)) {
             std::cout << textstring;
@@ -177,26 +328,114 @@ void rectangle(int left, int top, int right, int bottom) {
     int c2 = mapX(right);
     if (r2 <= r1 || c2 <= c1) return;
 
-    applyColor();
+    ensureFrame();
     // canh tren va duoi
-    moveCursor(r1, c1);
-    std::cout << "+" << std::string(c2 - c1 - 1, '=') << "+";
-    moveCursor(r2, c1);
-    std::cout << "+" << std::string(c2 - c1 - 1, '-') << "+";
+    putRun(r1, c1, '+', 1);
+    putRun(r1, c1 + 1, '=', c2 - c1 - 1);
+    putRun(r1, c2, '+', 1);
+    putRun(r2, c1, '+', 1);
+    putRun(r2, c1 + 1, '-', c2 - c1 - 1);
+    putRun(r2, c2, '+', 1);
     //khung phia ngoai (hai ben)
     for (int r = r1+1; r < r2; r++) {
-        moveCursor(r, c1);
-        std::cout << "|";
-        std::cout << "|";
-
-        moveCursor(r, c2);
-        std::cout << "|";
+        putRun(r, c1, '|', 2);
+        putRun(r, c2, '|', 1);
     }
-    std::cout << std::flush;
 }
 
 
-int getch() {
-    int c = std::getchar();
-    return c;
+void invalidatedevice() {
+    g_front_valid = false;
 }
+
+#ifndef _WIN32
+static int g_pending_key = -1;   // mã quét chờ lần getch() sau (phím mở rộng trả về 224 trước)
+
+// Một byte từ stdin; timeoutMs >= 0 chỉ dùng được với terminal, hết giờ trả về EOF
+static int readKeyByte(bool terminal, int timeoutMs) {
+    if (!terminal) return std::getchar();
+    if (timeoutMs >= 0) {
+        pollfd pfd{STDIN_FILENO, POLLIN, 0};
+        if (poll(&pfd, 1, timeoutMs) <= 0) return EOF;
+    }
+    unsigned char byte = 0;
+    return ::read(STDIN_FILENO, &byte, 1) == 1 ? byte : EOF;
+}
+
+// Đổi chuỗi ESC [ ... / ESC O ... của terminal sang mã quét kiểu conio (72 lên, 75 trái, ...).
+// Trả về -1 với chuỗi không biết, 27 khi chỉ là phím Esc.
+static int decodeEscape(bool terminal) {
+    int next = readKeyByte(terminal, 30);
+    if (next != '[' && next != 'O') {
+        if (next != EOF) g_pending_key = next;
+        return 27;
+    }
+    int param = 0;
+    int c = readKeyByte(terminal, 30);
+    while (c >= '0' && c <= '9') {
+        param = param * 10 + (c - '0');
+        c = readKeyByte(terminal, 30);
+    }
+    // bỏ các tham số phụ (ESC [ 1 ; 5 C ...)
+    while (c == ';' || (c >= '0' && c <= '9')) c = readKeyByte(terminal, 30);
+    switch (c) {
+        case 'A': return 72;
+        case 'B': return 80;
+        case 'C': return 77;
+        case 'D': return 75;
+        case 'H': return 71;
+        case 'F': return 79;
+        case '~':
+            switch (param) {
+                case 1: case 7: return 71;
+                case 4: case 8: return 79;
+                case 3: return 83;
+                case 5: return 73;
+                case 6: return 81;
+            }
+            break;
+    }
+    return -1;
+}
+#endif
+
+// Đọc một phím không chờ Enter và không để terminal tự in ký tự vừa gõ: chữ do terminal in ra
+// (và dòng bị cuộn khi Enter ở hàng cuối) nằm ngoài g_front nên lần vẽ so sánh sau sẽ lệch.
+// Phím mũi tên/PgUp/PgDn/Home/End trả về 224 rồi mã quét ở lần gọi sau, như _getch() của conio.
+int getch() {
+    // khung hình được đưa ra terminal ngay trước khi chờ phím
+    swapbuffers();
+#ifdef _WIN32
+    return _getch();
+#else
+    if (g_pending_key >= 0) {
+        int c = g_pending_key;
+        g_pending_key = -1;
+        return c;
+    }
+    termios saved;
+    // stdin không phải terminal (chuyển hướng từ file): không có gì được in lại
+    const bool terminal = isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &saved) == 0;
+    if (terminal) {
+        termios raw = saved;
+        raw.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+    int c = readKeyByte(terminal, -1);
+    while (c == 27) {
+        int key = decodeEscape(terminal);
+        if (key == 27) break;
+        if (key >= 0) {
+            g_pending_key = key;
+            c = 224;
+            break;
+        }
+        // chuỗi điều khiển không biết: bỏ qua, chờ phím khác
+        c = readKeyByte(terminal, -1);
+    }
+    if (terminal) tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    return c;
+#endif
+}
@@ -0,0 +1,407 @@
+#include "../lib/hub_labels.h"
+#include "../lib/mapped_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <new>
+#include <queue>
+#include <vector>
+
+namespace {
+const int INF = std::numeric_limits<int>::max();
+const long long UNREACHED = std::numeric_limits<long long>::max();
+const std::uint64_t SECTION_ALIGN = 64;
+
+std::uint64_t alignUp(std::uint64_t pos) {
+    return (pos + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+}
+
+std::uint64_t fnv1a(std::uint64_t hash, const void* data, std::uint64_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::uint64_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::uint64_t csrFingerprint(const CsrGraph& csr) {
+    const std::uint64_t V = static_cast<std::uint64_t>(csr.getVertexCount());
+    const std::uint64_t E = static_cast<std::uint64_t>(csr.getEdgeCount());
+    std::uint64_t hash = 1469598103934665603ULL;
+    hash = fnv1a(hash, csr.getOffsets(), (V + 1) * sizeof(int));
+    hash = fnv1a(hash, csr.getTargets(), E * sizeof(int));
+    hash = fnv1a(hash, csr.getWeights(), E * sizeof(int));
+    return hash;
+}
+
+struct LabelEntry {
+    std::uint32_t hub;
+    int dist;
+    int parent;
+};
+
+using Item = std::pair<long long, int>;
+using MinQueue = std::priority_queue<Item, std::vector<Item>, std::greater<Item>>;
+
+// Dijkstra có cắt tỉa từ đỉnh có hạng `hub`. rootLabel là nhãn của gốc theo chiều ngược lại
+// (đã nạp vào hubDist), checkLabels là nhãn của đỉnh đang xét cùng chiều: nếu hai nhãn
+// đã cho được khoảng cách <= d thì đỉnh bị cắt, ngược lại thêm hub vào addLabels.
+class PrunedSearch {
+public:
+    explicit PrunedSearch(int V) : dist(V, UNREACHED), parent(V, -1), hubDist(V, INF) {}
+
+    void run(const CsrGraph& csr, int root, std::uint32_t hub, const std::vector<LabelEntry>& rootLabel,
+             const std::vector<std::vector<LabelEntry>>& checkLabels, std::vector<std::vector<LabelEntry>>& addLabels) {
+        for (const auto& e : rootLabel) hubDist[e.hub] = e.dist;
+
+        const int* offsets = csr.getOffsets();
+        const int* targets = csr.getTargets();
+        const int* weights = csr.getWeights();
+        MinQueue pq;
+        dist[root] = 0;
+        touched.push_back(root);
+        pq.push({0, root});
+        while (!pq.empty()) {
+            auto [d, v] = pq.top();
+            pq.pop();
+            if (d > dist[v]) continue;
+
+            bool covered = false;
+            for (const auto& e : checkLabels[v]) {
+                if (hubDist[e.hub] != INF && static_cast<long long>(hubDist[e.hub]) + e.dist <= d) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered) continue;
+            addLabels[v].push_back({hub, static_cast<int>(d), parent[v]});
+
+            for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                int w = targets[i];
+                long long candidate = d + weights[i];
+                if (candidate < dist[w]) {
+                    if (dist[w] == UNREACHED) touched.push_back(w);
+                    dist[w] = candidate;
+                    parent[w] = v;
+                    pq.push({candidate, w});
+                }
+            }
+        }
+
+        for (int v : touched) {
+            dist[v] = UNREACHED;
+            parent[v] = -1;
+        }
+        touched.clear();
+        for (const auto& e : rootLabel) hubDist[e.hub] = INF;
+    }
+
+private:
+    std::vector<long long> dist;
+    std::vector<int> parent;
+    std::vector<int> hubDist;          // theo hạng hub
+    std::vector<int> touched;
+};
+
+// Đường qua vòng trọng số 0 có thể lặp đỉnh ở chỗ nối hai nửa; bỏ vòng, độ dài không đổi
+void eraseLoops(std::vector<int>& path, int V) {
+    std::vector<int> position(V, -1);
+    size_t kept = 0;
+    for (size_t i = 0; i < path.size(); i++) {
+        int v = path[i];
+        if (position[v] >= 0) {
+            for (size_t j = position[v] + 1; j < kept; j++) position[path[j]] = -1;
+            kept = position[v] + 1;
+            continue;
+        }
+        position[v] = static_cast<int>(kept);
+        path[kept++] = v;
+    }
+    path.resize(kept);
+}
+} // namespace
+
+HubLabels::HubLabels()
+    : V(0), header(nullptr), order(nullptr), outOffsets(nullptr), outHubs(nullptr), outDists(nullptr),
+      outParents(nullptr), inOffsets(nullptr), inHubs(nullptr), inDists(nullptr), inParents(nullptr) {}
+
+bool HubLabels::build(const Graph& graph, bool withPaths) {
+    *this = HubLabels();
+    if (!graph.isValid() || graph.hasNegativeWeights()) return false;
+
+    CsrGraph forward(graph);
+    CsrGraph backward = forward.reversed();
+    const int n = forward.getVertexCount();
+    const int m = forward.getEdgeCount();
+
+    // đỉnh bậc cao phủ được nhiều đường đi ngắn nhất nhất, nên làm hub trước
+    std::vector<int> hubOrder(n);
+    for (int v = 0; v < n; v++) hubOrder[v] = v;
+    std::stable_sort(hubOrder.begin(), hubOrder.end(), [&](int a, int b) {
+        return forward.degree(a) + backward.degree(a) > forward.degree(b) + backward.degree(b);
+    });
+
+    std::vector<std::vector<LabelEntry>> outLabels(n);
+    std::vector<std::vector<LabelEntry>> inLabels(n);
+    PrunedSearch search(n);
+    for (int k = 0; k < n; k++) {
+        const int h = hubOrder[k];
+        const std::uint32_t hub = static_cast<std::uint32_t>(k);
+        // xuôi: d(h, v) vào in(v), kiểm tra bằng out(h) + in(v)
+        search.run(forward, h, hub, outLabels[h], inLabels, inLabels);
+        // ngược: d(v, h) vào out(v), kiểm tra bằng out(v) + in(h)
+        search.run(backward, h, hub, inLabels[h], outLabels, outLabels);
+    }
+
+    // bố cục giống hệt file (xem hub_labels.h)
+    std::uint64_t outCount = 0;
+    std::uint64_t inCount = 0;
+    for (int v = 0; v < n; v++) {
+        outCount += outLabels[v].size() + 1;
+        inCount += inLabels[v].size() + 1;
+    }
+    HubLabelsHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, HUB_LABELS_MAGIC, sizeof(h.magic));
+    h.version = HUB_LABELS_VERSION;
+    h.hasParents = withPaths ? 1 : 0;
+    h.vertexCount = n;
+    h.edgeCount = m;
+    h.fingerprint = csrFingerprint(forward);
+
+    std::uint64_t pos = sizeof(HubLabelsHeader);
+    auto section = [&](std::uint64_t bytes) {
+        std::uint64_t at = alignUp(pos);
+        pos = at + bytes;
+        return at;
+    };
+    h.orderPos = section(static_cast<std::uint64_t>(n) * sizeof(int));
+    h.outOffsetsPos = section((static_cast<std::uint64_t>(n) + 1) * sizeof(std::uint64_t));
+    h.outHubsPos = section(outCount * sizeof(std::uint32_t));
+    h.outDistsPos = section(outCount * sizeof(int));
+    h.outParentsPos = withPaths ? section(outCount * sizeof(int)) : 0;
+    h.inOffsetsPos = section((static_cast<std::uint64_t>(n) + 1) * sizeof(std::uint64_t));
+    h.inHubsPos = section(inCount * sizeof(std::uint32_t));
+    h.inDistsPos = section(inCount * sizeof(int));
+    h.inParentsPos = withPaths ? section(inCount * sizeof(int)) : 0;
+    h.fileBytes = alignUp(pos);
+
+    // khối nhớ căn lề 64 byte để các phần (đã căn lề tương đối) cũng thẳng hàng với cache line
+    char* raw = static_cast<char*>(::operator new(h.fileBytes, std::align_val_t(SECTION_ALIGN)));
+    std::shared_ptr<char> buffer(raw, [](char* p) { ::operator delete(p, std::align_val_t(SECTION_ALIGN)); });
+    std::memset(raw, 0, h.fileBytes);
+    std::memcpy(raw, &h, sizeof(h));
+    std::memcpy(raw + h.orderPos, hubOrder.data(), static_cast<size_t>(n) * sizeof(int));
+
+    auto fill = [&](const std::vector<std::vector<LabelEntry>>& labels, std::uint64_t offsetsPos,
+                    std::uint64_t hubsPos, std::uint64_t distsPos, std::uint64_t parentsPos) {
+        auto* offsets = reinterpret_cast<std::uint64_t*>(raw + offsetsPos);
+        auto* hubs = reinterpret_cast<std::uint32_t*>(raw + hubsPos);
+        auto* dists = reinterpret_cast<int*>(raw + distsPos);
+        auto* parents = parentsPos ? reinterpret_cast<int*>(raw + parentsPos) : nullptr;
+        std::uint64_t at = 0;
+        for (int v = 0; v < n; v++) {
+            offsets[v] = at;
+            for (const auto& e : labels[v]) {
+                hubs[at] = e.hub;
+                dists[at] = e.dist;
+                if (parents) parents[at] = e.parent;
+                at++;
+            }
+            hubs[at] = HUB_SENTINEL;
+            if (parents) parents[at] = -1;
+            at++;
+        }
+        offsets[n] = at;
+    };
+    fill(outLabels, h.outOffsetsPos, h.outHubsPos, h.outDistsPos, h.outParentsPos);
+    fill(inLabels, h.inOffsetsPos, h.inHubsPos, h.inDistsPos, h.inParentsPos);
+
+    return attach(raw, h.fileBytes, buffer);
+}
+
+bool HubLabels::attach(const char* base, std::uint64_t bytes, std::shared_ptr<const void> owner) {
+    if (bytes < sizeof(HubLabelsHeader)) return false;
+    const auto* h = reinterpret_cast<const HubLabelsHeader*>(base);
+    if (std::memcmp(h->magic, HUB_LABELS_MAGIC, sizeof(h->magic)) != 0 || h->version != HUB_LABELS_VERSION) {
+        return false;
+    }
+    if (h->vertexCount <= 0 || h->vertexCount >= 0x7fffffffLL || h->fileBytes != bytes) return false;
+
+    const std::uint64_t n = static_cast<std::uint64_t>(h->vertexCount);
+    auto inside = [&](std::uint64_t pos, std::uint64_t size) {
+        return pos % SECTION_ALIGN == 0 && pos >= sizeof(HubLabelsHeader) && pos <= bytes && size <= bytes - pos;
+    };
+    if (!inside(h->orderPos, n * sizeof(int)) ||
+        !inside(h->outOffsetsPos, (n + 1) * sizeof(std::uint64_t)) ||
+        !inside(h->inOffsetsPos, (n + 1) * sizeof(std::uint64_t))) {
+        return false;
+    }
+
+    // offsets tăng dần và mỗi nhãn kết thúc bằng sentinel, để vòng trộn không đọc ra ngoài
+    auto validLabels = [&](std::uint64_t offsetsPos, std::uint64_t hubsPos, std::uint64_t distsPos,
+                           std::uint64_t parentsPos) {
+        const auto* offsets = reinterpret_cast<const std::uint64_t*>(base + offsetsPos);
+        const std::uint64_t count = offsets[n];
+        if (count >= bytes || !inside(hubsPos, count * sizeof(std::uint32_t)) ||
+            !inside(distsPos, count * sizeof(int))) {
+            return false;
+        }
+        if ((parentsPos != 0) != (h->hasParents != 0)) return false;
+        if (parentsPos != 0 && !inside(parentsPos, count * sizeof(int))) return false;
+        const auto* hubs = reinterpret_cast<const std::uint32_t*>(base + hubsPos);
+        if (offsets[0] != 0) return false;
+        for (std::uint64_t v = 0; v < n; v++) {
+            if (offsets[v + 1] <= offsets[v] || hubs[offsets[v + 1] - 1] != HUB_SENTINEL) return false;
+        }
+        return true;
+    };
+    if (!validLabels(h->outOffsetsPos, h->outHubsPos, h->outDistsPos, h->outParentsPos) ||
+        !validLabels(h->inOffsetsPos, h->inHubsPos, h->inDistsPos, h->inParentsPos)) {
+        return false;
+    }
+
+    V = static_cast<int>(n);
+    storage = std::move(owner);
+    header = h;
+    order = reinterpret_cast<const int*>(base + h->orderPos);
+    outOffsets = reinterpret_cast<const std::uint64_t*>(base + h->outOffsetsPos);
+    outHubs = reinterpret_cast<const std::uint32_t*>(base + h->outHubsPos);
+    outDists = reinterpret_cast<const int*>(base + h->outDistsPos);
+    outParents = h->hasParents ? reinterpret_cast<const int*>(base + h->outParentsPos) : nullptr;
+    inOffsets = reinterpret_cast<const std::uint64_t*>(base + h->inOffsetsPos);
+    inHubs = reinterpret_cast<const std::uint32_t*>(base + h->inHubsPos);
+    inDists = reinterpret_cast<const int*>(base + h->inDistsPos);
+    inParents = h->hasParents ? reinterpret_cast<const int*>(base + h->inParentsPos) : nullptr;
+    return true;
+}
+
+bool HubLabels::save(const std::string& filename) const {
+    if (!isBuilt()) return false;
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(header), static_cast<std::streamsize>(header->fileBytes));
+    return file.good();
+}
+
+bool HubLabels::open(const std::string& filename, const CsrGraph& csr) {
+    *this = HubLabels();
+    auto m = std::make_shared<MappedFile>();
+    if (!m->open(filename) || m->size() < sizeof(HubLabelsHeader)) return false;
+
+    const auto* h = reinterpret_cast<const HubLabelsHeader*>(m->data());
+    if (h->vertexCount != csr.getVertexCount() || h->edgeCount != csr.getEdgeCount() ||
+        h->fingerprint != csrFingerprint(csr)) {
+        return false;
+    }
+    const char* base = m->data();
+    const std::uint64_t bytes = m->size();
+    if (!attach(base, bytes, m)) {
+        *this = HubLabels();
+        return false;
+    }
+    return true;
+}
+
+long long HubLabels::getEntryCount() const {
+    if (!isBuilt()) return 0;
+    return static_cast<long long>(outOffsets[V] + inOffsets[V]) - 2LL * V;
+}
+
+double HubLabels::averageLabelSize() const {
+    return isBuilt() ? static_cast<double>(getEntryCount()) / (2.0 * V) : 0.0;
+}
+
+long long HubLabels::memoryUsageBytes() const {
+    return isBuilt() ? static_cast<long long>(header->fileBytes) : 0;
+}
+
+long long HubLabels::findHub(const std::uint32_t* hubs, std::uint64_t first, std::uint64_t last, std::uint32_t hub) {
+    const std::uint32_t* it = std::lower_bound(hubs + first, hubs + last, hub);
+    if (it == hubs + last || *it != hub) return -1;
+    return static_cast<long long>(it - hubs);
+}
+
+int HubLabels::distance(int source, int target) const {
+    if (!isBuilt() || source < 0 || source >= V || target < 0 || target >= V) return -1;
+
+    const std::uint32_t* a = outHubs + outOffsets[source];
+    const std::uint32_t* b = inHubs + inOffsets[target];
+    const int* da = outDists + outOffsets[source];
+    const int* db = inDists + inOffsets[target];
+    long long best = UNREACHED;
+    // cả hai nhãn kết thúc bằng HUB_SENTINEL nên chỉ cần dừng khi hai bên cùng gặp sentinel
+    while (true) {
+        if (*a == *b) {
+            if (*a == HUB_SENTINEL) break;
+            best = std::min(best, static_cast<long long>(*da) + *db);
+            a++, da++, b++, db++;
+        } else if (*a < *b) {
+            a++, da++;
+        } else {
+            b++, db++;
+        }
+    }
+    return best == UNREACHED ? -1 : static_cast<int>(best);
+}
+
+PointToPointResult HubLabels::query(int source, int target) const {
+    PointToPointResult result;
+    if (!isBuilt() || source < 0 || source >= V || target < 0 || target >= V) return result;
+
+    std::uint64_t i = outOffsets[source];
+    std::uint64_t j = inOffsets[target];
+    long long best = UNREACHED;
+    std::uint32_t bestHub = HUB_SENTINEL;
+    while (true) {
+        if (outHubs[i] == inHubs[j]) {
+            if (outHubs[i] == HUB_SENTINEL) break;
+            long long candidate = static_cast<long long>(outDists[i]) + inDists[j];
+            if (candidate < best) {
+                best = candidate;
+                bestHub = outHubs[i];
+            }
+            i++;
+            j++;
+        } else if (outHubs[i] < inHubs[j]) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    result.settledVertices = static_cast<int>((i - outOffsets[source]) + (j - inOffsets[target]));
+    if (best == UNREACHED) return result;
+
+    result.found = true;
+    result.distance = static_cast<int>(best);
+    if (!hasPaths()) return result;
+
+    // nửa đầu: theo đỉnh kế tiếp trong out(v) tới hub; nửa sau: theo đỉnh trước trong in(v) lùi từ target
+    const int hubVertex = order[bestHub];
+    result.path.push_back(source);
+    for (int v = source, steps = 0; v != hubVertex; steps++) {
+        long long at = findHub(outHubs, outOffsets[v], outOffsets[v + 1], bestHub);
+        if (at < 0 || steps >= V || outParents[at] < 0 || outParents[at] >= V) {
+            result.path.clear();
+            return result;
+        }
+        v = outParents[at];
+        result.path.push_back(v);
+    }
+    std::vector<int> tail;
+    for (int v = target, steps = 0; v != hubVertex; steps++) {
+        long long at = findHub(inHubs, inOffsets[v], inOffsets[v + 1], bestHub);
+        if (at < 0 || steps >= V || inParents[at] < 0 || inParents[at] >= V) {
+            result.path.clear();
+            return result;
+        }
+        tail.push_back(v);
+        v = inParents[at];
+    }
+    result.path.insert(result.path.end(), tail.rbegin(), tail.rend());
+    eraseLoops(result.path, V);
+    return result;
+}
@@ -0,0 +1,110 @@
+#include "../lib/log_pager.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+// Số dòng gốc đọc mỗi lần khi tìm kiếm / khi đọc trước để lập chỉ mục
+const size_t SEARCH_BLOCK = 1024;
+const size_t READ_AHEAD = 256;
+} // namespace
+
+LogPager::LogPager(const LogSource& logs, size_t pageLines, WrapFunction wrapLine)
+    : source(logs), linesPerPage(std::max<size_t>(1, pageLines)), wrap(std::move(wrapLine)),
+      totalLines(logs.lineCount()), starts{{0, 0}}, complete(false), blockFirst(0) {}
+
+const std::pair<int, std::string>* LogPager::fetch(size_t line) const {
+    if (line < blockFirst || line >= blockFirst + block.size()) {
+        block.clear();
+        blockFirst = line;
+        source.lines(line, std::max(linesPerPage, READ_AHEAD), block);
+        if (block.empty()) return nullptr;
+    }
+    return &block[line - blockFirst];
+}
+
+LogPager::Anchor LogPager::walk(Anchor from, std::vector<Line>* out) const {
+    Anchor at = from;
+    size_t filled = 0;
+    while (filled < linesPerPage && at.line < totalLines) {
+        const std::pair<int, std::string>* raw = fetch(at.line);
+        if (!raw) {
+            at = {totalLines, 0};
+            break;
+        }
+        std::vector<std::string> parts = wrap(raw->second);
+        size_t part = at.part;
+        for (; part < parts.size() && filled < linesPerPage; part++, filled++) {
+            if (out) out->push_back({raw->first, std::move(parts[part]), at.line});
+        }
+        if (part < parts.size()) {
+            // Trang đầy giữa một dòng dài: trang sau bắt đầu từ phần còn lại
+            at.part = part;
+            return at;
+        }
+        at.line++;
+        at.part = 0;
+    }
+    return at;
+}
+
+// Ghi nhận vị trí đầu trang index + 1 vừa tìm được khi đi qua trang index
+void LogPager::record(size_t index, Anchor next) {
+    if (complete || index + 1 != starts.size()) return;
+    if (next.line >= totalLines) {
+        complete = true;
+    } else {
+        starts.push_back(next);
+    }
+}
+
+void LogPager::extendTo(size_t index) {
+    while (!complete && starts.size() <= index) {
+        const size_t last = starts.size() - 1;
+        record(last, walk(starts[last], nullptr));
+    }
+}
+
+bool LogPager::page(size_t index, std::vector<Line>& out) {
+    extendTo(index);
+    if (index >= starts.size()) return false;
+    out.clear();
+    record(index, walk(starts[index], &out));
+    return true;
+}
+
+bool LogPager::isLastPage(size_t index) {
+    extendTo(index + 1);
+    return index + 1 >= starts.size();
+}
+
+size_t LogPager::pageCount() {
+    extendTo(static_cast<size_t>(-1) - 1);
+    return starts.size();
+}
+
+size_t LogPager::pageOfLine(size_t line) {
+    while (!complete && starts.back().line <= line) {
+        extendTo(starts.size());
+    }
+    // Trang cuối cùng bắt đầu không sau phần đầu của dòng line
+    auto it = std::upper_bound(starts.begin(), starts.end(), line, [](size_t value, const Anchor& anchor) {
+        return value < anchor.line || (value == anchor.line && anchor.part > 0);
+    });
+    return static_cast<size_t>(it - starts.begin()) - 1;
+}
+
+size_t LogPager::find(const std::string& text, size_t fromLine) const {
+    if (text.empty()) return NOT_FOUND;
+    std::vector<std::pair<int, std::string>> lines;
+    for (size_t first = fromLine; first < totalLines; first += SEARCH_BLOCK) {
+        lines.clear();
+        source.lines(first, SEARCH_BLOCK, lines);
+        for (size_t i = 0; i < lines.size(); i++) {
+            if (lines[i].second.find(text) != std::string::npos) {
+                return first + i;
+            }
+        }
+        if (lines.empty()) break;
+    }
+    return NOT_FOUND;
+}
@@ -2,10 +2,12 @@
 #include <limits>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <sstream>
+#include <thread>
 #ifdef _WIN32
 #include <windows.h>
 #include <cwchar>
@@ -16,6 +18,11 @@
 #include "../lib/graph.h"
 #include "../lib/Algorithms.h"
 #include "../lib/Comparison.h"
+#include "../lib/csr_graph.h"
+#include "../lib/event_trace.h"
+#include "../lib/alt_landmarks.h"
+#include "../lib/hub_labels.h"
+#include "../lib/graph_generator.h"
 
 Graph graph;
 Algorithms* algorithms = nullptr;
@@ -23,6 +30,8 @@ Comparison* comparison = nullptr;
 GUI* gui = nullptr;
 
 PathResult lastResult;
+// Chỉ mục ALT của đồ thị đang dùng; với đồ thị tải từ file được lưu cạnh file đó (<file>.alt)
+AltIndex altIndex;
 
 #ifdef _WIN32
 static void initConsoleUtf8() {
@@ -43,6 +52,26 @@ static void initConsoleUtf8() {
 }
 #endif
 
+// File đuôi .bin dùng định dạng nhị phân (binary_graph.h), còn lại là file văn bản
+static bool isBinaryGraphFile(const std::string& filename) {
+    return std::filesystem::path(filename).extension() == ".bin";
+}
+
+static bool loadGraphFile(const std::string& filename, bool& needCreate) {
+    altIndex = AltIndex();
+    if (isBinaryGraphFile(filename)) {
+        return graph.readFromBinaryFile(filename, needCreate);
+    }
+    return graph.readFromFile(filename, needCreate);
+}
+
+static bool saveGraphFile(const std::string& filename) {
+    if (isBinaryGraphFile(filename)) {
+        return graph.saveToBinaryFile(filename);
+    }
+    return graph.saveToFile(filename);
+}
+
 static bool promptGraphDirected() {
     std::vector<std::string> options = {
         "[1]. Có hướng",
@@ -52,8 +81,24 @@ static bool promptGraphDirected() {
     return choice == 1;
 }
 
+// Đọc lại bảng landmark đã lưu cho đúng đồ thị này, nếu không có thì dựng và lưu vào indexFile.
+// Gọi sau makeUndirected: file .alt ghi dấu vân tay CSR nên bản có hướng/vô hướng không lẫn nhau
+static void prepareAltIndex(const std::string& indexFile) {
+    altIndex = AltIndex();
+    if (!graph.isValid() || graph.hasNegativeWeights()) {
+        return;
+    }
+    if (!indexFile.empty() && altIndex.load(indexFile, graph.getCsr())) {
+        return;
+    }
+    if (altIndex.build(graph) && !indexFile.empty()) {
+        altIndex.save(indexFile);
+    }
+}
+
 static void createGraphFromGui(bool isDirected) {
     graph.clear();
+    altIndex = AltIndex();
 
     int numVertices = 0;
     int numEdges = 0;
@@ -63,12 +108,7 @@ static void createGraphFromGui(bool isDirected) {
         graph.addVertex(std::to_string(i + 1));
     }
 
-    for (const auto& edge : edges) {
-        int source = std::get<0>(edge);
-        int dest = std::get<1>(edge);
-        int weight = std::get<2>(edge);
-        graph.addEdge(source, dest, weight);
-    }
+    graph.addEdges(edges, DuplicatePolicy::KEEP_LAST);
 
     if (!isDirected) {
         graph.makeUndirected();
@@ -77,14 +117,200 @@ static void createGraphFromGui(bool isDirected) {
     gui->showGraphSummary(numVertices, numEdges, edges, isDirected);
 }
 
+// Đo trên các đồ thị mẫu G1..G7 trong thư mục dữ liệu
+static std::vector<std::string> sampleGraphFiles() {
+    std::vector<std::string> files;
+    for (int i = 1; i <= 7; i++) {
+        std::string file = DATA_FOLDER + "/G" + std::to_string(i) + ".txt";
+        if (std::filesystem::exists(file)) {
+            files.push_back(file);
+        }
+    }
+    return files;
+}
+
+// Chỉ mục (.alt/.hub) mà phép đo trên G1..G7 dựng ra đặt trong thư mục tạm, không ghi vào thư mục
+// dữ liệu dùng chung; đồ thị người dùng tải vào thì lưu .alt cạnh file của nó (prepareAltIndex)
+static std::string benchmarkCachePath(const std::string& graphFile) {
+    std::error_code ec;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    if (ec) return std::string();
+    return (dir / std::filesystem::path(graphFile).filename()).string();
+}
+
+static void benchmarkSampleGraphs() {
+    auto files = sampleGraphFiles();
+    if (files.empty()) {
+        gui->showMessage("ĐỒ THỊ MẪU", {"Không tìm thấy G1..G7 trong " + DATA_FOLDER});
+        return;
+    }
+
+    auto parsers = Comparison::benchmarkParsers(files);
+    gui->drawComparisonScreen(parsers.logs);
+    gui->waitForKey();
+
+    // bảng engine cho từng đồ thị mẫu, đỉnh bắt đầu là đỉnh 1
+    std::vector<std::string> logs;
+    for (const auto& file : files) {
+        Graph sample;
+        bool needCreate = false;
+        if (!sample.readFromFile(file, needCreate) || !sample.isValid()) continue;
+        Comparison sampleComparison(sample);
+        auto report = sampleComparison.compareEngines(0, Comparison::registeredEngines());
+        logs.push_back(std::filesystem::path(file).filename().string());
+        logs.insert(logs.end(), report.logs.begin() + 3, report.logs.end());
+
+        std::vector<int> threadCounts;
+        for (int t = 1; t <= std::max(1, static_cast<int>(std::thread::hardware_concurrency())); t *= 2) {
+            threadCounts.push_back(t);
+        }
+        auto allPairs = sampleComparison.benchmarkAllPairs(threadCounts);
+        logs.insert(logs.end(), allPairs.logs.begin() + 3, allPairs.logs.end());
+
+        // bảng landmark lưu trong thư mục tạm (Gx.txt.alt), lần sau chỉ cần đọc lại
+        if (!sample.hasNegativeWeights()) {
+            std::string cached = benchmarkCachePath(file);
+            AltIndex alt;
+            const CsrGraph& csr = sample.getCsr();
+            if ((cached.empty() || !alt.load(AltIndex::pathFor(cached), csr)) && alt.build(sample) &&
+                !cached.empty()) {
+                alt.save(AltIndex::pathFor(cached));
+            }
+            auto queries = sampleComparison.benchmarkPointToPoint(100, 1, &alt);
+            logs.insert(logs.end(), queries.logs.begin() + 3, queries.logs.end());
+
+            // nhãn hub của phép đo cũng nằm trong thư mục tạm (<tmp>/Gx.txt.hub), không cạnh G1..G7 trong
+            // thư mục dữ liệu; lần đo sau mmap lại file đó nếu dấu vân tay CSR còn khớp
+            HubLabels labels;
+            if ((cached.empty() || !labels.open(HubLabels::pathFor(cached), csr)) && labels.build(sample) &&
+                !cached.empty()) {
+                labels.save(HubLabels::pathFor(cached));
+            }
+            auto oracle = sampleComparison.benchmarkHubLabels(1000, 1, &labels);
+            logs.insert(logs.end(), oracle.logs.begin() + 3, oracle.logs.end());
+        }
+    }
+    gui->drawComparisonScreen(logs);
+    gui->waitForKey();
+
+    if (!gui->promptYesNo("ĐỒ THỊ MẪU", "Đo thêm trên đồ thị ngẫu nhiên lớn?")) {
+        return;
+    }
+    int millions = gui->promptInt("ĐỒ THỊ NGẪU NHIÊN", "Số cạnh (triệu, 1-100): ", 1, 100);
+    int edges = millions * 1000000;
+
+    // tốc độ đọc file văn bản cùng kích thước (file tạm, xóa sau khi đo)
+    auto syntheticParsers = Comparison::benchmarkSyntheticParsers({edges});
+    gui->drawComparisonScreen(syntheticParsers.logs);
+    gui->waitForKey();
+
+    Graph synthetic;
+    generateRandomGraph(synthetic, edges / 8, edges, 1, 1000);
+    Comparison syntheticComparison(synthetic);
+
+    auto report = syntheticComparison.compareEngines(0, {
+        AlgorithmType::DIJKSTRA,
+        AlgorithmType::DIJKSTRA_BINARY_DARY_HEAP,
+        AlgorithmType::DIJKSTRA_DARY_HEAP,
+        AlgorithmType::DIJKSTRA_OCTAL_DARY_HEAP,
+        AlgorithmType::DIJKSTRA_RADIX_HEAP,
+        AlgorithmType::DIJKSTRA_AUTO,
+        AlgorithmType::DELTA_STEPPING
+    }, 1);
+    std::vector<int> threadCounts;
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    for (int t = 1; t <= std::max(1, maxThreads); t *= 2) {
+        threadCounts.push_back(t);
+    }
+    auto scaling = syntheticComparison.benchmarkThreadScaling(0, threadCounts);
+    report.logs.insert(report.logs.end(), scaling.logs.begin(), scaling.logs.end());
+    // đồ thị ngẫu nhiên không có phân cấp nên bỏ CH/CCH: co đỉnh sinh quá nhiều shortcut
+    auto pointToPoint = syntheticComparison.benchmarkPointToPoint(20, 1, nullptr, false);
+    report.logs.insert(report.logs.end(), pointToPoint.logs.begin(), pointToPoint.logs.end());
+    gui->drawComparisonScreen(report.logs);
+    gui->waitForKey();
+
+    // cùng kích thước, trọng số âm không có chu trình âm: các engine gán nhãn (Bellman-Ford V - 1 lượt quá chậm).
+    // Dòng Johnson chỉ tính truy vấn; Bellman-Ford tính thế năng in thành dòng tiền xử lý dưới bảng
+    Graph negative;
+    generateNegativeWeightGraph(negative, edges / 8, edges, 1, 1000, 1000);
+    Comparison negativeComparison(negative);
+    auto negativeReport = negativeComparison.compareEngines(0, {
+        AlgorithmType::BELLMAN_FORD_SPFA,
+        AlgorithmType::GOLDBERG_RADZIK,
+        AlgorithmType::DIJKSTRA_JOHNSON
+    }, 1);
+    gui->drawComparisonScreen(negativeReport.logs);
+    gui->waitForKey();
+}
+
+// Tóm tắt đồ thị vừa tải (trước khi thêm cung ngược nếu là đồ thị vô hướng)
+static void showLoadedGraph(bool isDirected) {
+    // chỉ lấy các cạnh được in ra (5 đầu, 5 cuối khi nhiều cạnh), đọc từ CSR để đồ thị .bin
+    // không phải chép toàn bộ cạnh ra danh sách kề
+    std::vector<std::tuple<int, int, int>> fileEdges;
+    int V = graph.getVertexCount();
+    int fileE = graph.getEdgeCount();
+    const CsrGraph& csr = graph.getCsr();
+    const int* offsets = csr.getOffsets();
+    const int* targets = csr.getTargets();
+    const int* weights = csr.getWeights();
+    const int shown = 5;
+    for (int u = 0; u < V; ++u) {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+            if (fileE <= 2 * shown + 2 || i < shown || i >= fileE - shown) {
+                fileEdges.push_back({u, targets[i], weights[i]});
+            } else {
+                // bỏ qua phần giữa, tới cạnh thứ fileE - shown
+                i = std::min(offsets[u + 1], fileE - shown) - 1;
+            }
+        }
+    }
+
+    if (!isDirected) {
+        graph.makeUndirected();
+    }
+    lastResult = PathResult();
+    
+    gui->showGraphSummary(V, fileE, fileEdges, isDirected);
+}
+
+// Chọn một trong các đồ thị mẫu G1..G7 làm đồ thị hiện tại
+static void loadSampleGraph() {
+    auto files = sampleGraphFiles();
+    if (files.empty()) {
+        gui->showMessage("ĐỒ THỊ MẪU", {"Không tìm thấy G1..G7 trong " + DATA_FOLDER});
+        return;
+    }
+
+    std::vector<std::string> options;
+    for (size_t i = 0; i < files.size(); i++) {
+        options.push_back("[" + std::to_string(i + 1) + "]. " + std::filesystem::path(files[i]).filename().string());
+    }
+    int count = static_cast<int>(files.size());
+    int choice = gui->promptChoice("ĐỒ THỊ MẪU", options, "Nhập lựa chọn:", 1, count);
+    bool isDirected = promptGraphDirected();
+
+    bool needCreate = false;
+    altIndex = AltIndex();
+    if (!graph.readFromFile(files[choice - 1], needCreate)) {
+        gui->showMessage("ĐỒ THỊ MẪU", {"Tải file thất bại."});
+        return;
+    }
+    showLoadedGraph(isDirected);
+    std::string cached = benchmarkCachePath(files[choice - 1]);
+    prepareAltIndex(cached.empty() ? std::string() : AltIndex::pathFor(cached));
+}
+
 static void handleGraphInput() {
     std::vector<std::string> options = {
         "[1]. Tải từ file",
         "[2]. Tạo đồ thị mới (nhập trực tiếp)",
         "[3]. Các đồ thị mẫu dùng để so sánh",
-        "[4]. Quay lại"
+        "[4]. Đo hiệu năng trên các đồ thị mẫu",
+        "[5]. Quay lại"
     };
-    int choice = gui->promptChoice("TẠO/TẢI ĐỒ THỊ", options, "Nhập lựa chọn:", 1, 4);
+    int choice = gui->promptChoice("TẠO/TẢI ĐỒ THỊ", options, "Nhập lựa chọn:", 1, 5);
 
     if (choice == 1) {
         bool isDirected = promptGraphDirected();
@@ -93,13 +319,13 @@ static void handleGraphInput() {
             DEFAULT_GRAPH_FILE
         );
         bool needCreate = false;
-        if (!graph.readFromFile(filename, needCreate)) {
+        if (!loadGraphFile(filename, needCreate)) {
             if (needCreate) {
                 bool create = gui->promptYesNo("TẢI ĐỒ THỊ", "Không tìm thấy file. Tạo file mới?");
                 if (create) {
                     createGraphFromGui(isDirected);
                     lastResult = PathResult();
-                    if (graph.saveToFile(filename)) {
+                    if (saveGraphFile(filename)) {
                         gui->showMessage("TẢI ĐỒ THỊ", {"Đã lưu đồ thị vào: " + filename});
                     } else {
                         gui->showMessage("TẢI ĐỒ THỊ", {"Lưu đồ thị thất bại."});
@@ -109,22 +335,8 @@ static void handleGraphInput() {
                 gui->showMessage("TẢI ĐỒ THỊ", {"Tải file thất bại."});
             }
         } else {
-            std::vector<std::tuple<int, int, int>> fileEdges;
-            int V = graph.getVertexCount();
-            int fileE = graph.getEdgeCount();
-            auto adj = graph.getAdjacencyList();
-            for (int u = 0; u < V; ++u) {
-                for (const auto& edge : adj[u]) {
-                    fileEdges.push_back({u, edge.destination, edge.weight});
-                }
-            }
-
-            if (!isDirected) {
-                graph.makeUndirected();
-            }
-            lastResult = PathResult();
-            
-            gui->showGraphSummary(V, fileE, fileEdges, isDirected);
+            showLoadedGraph(isDirected);
+            prepareAltIndex(AltIndex::pathFor(filename));
         }
     } 
     else if (choice == 2) {
@@ -139,7 +351,7 @@ static void handleGraphInput() {
                 "Đường dẫn file (mặc định: " + DEFAULT_GRAPH_FILE + "): ",
                 DEFAULT_GRAPH_FILE
             );
-            if (graph.saveToFile(filename)) {
+            if (saveGraphFile(filename)) {
                 gui->showMessage("TẠO ĐỒ THỊ", {"Đã lưu đồ thị vào " + filename});
             } else {
                 gui->showMessage("TẠO ĐỒ THỊ", {"Lưu đồ thị thất bại."});
@@ -147,8 +359,10 @@ static void handleGraphInput() {
         }
     }
     else if(choice == 3){   
-        
-
+        loadSampleGraph();
+    }
+    else if (choice == 4) {
+        benchmarkSampleGraphs();
     }
 }
 
@@ -158,10 +372,8 @@ static void runAlgorithm(AlgorithmType type) {
         return;
     }
 
-    if (type == AlgorithmType::DIJKSTRA && graph.hasNegativeWeights()) {
-        gui->showMessage("THÔNG BÁO", {"Dijkstra không chạy được với cạnh có trọng số âm."});
-        return;
-    }
+    // trọng số âm: Dijkstra chạy trên trọng số rút gọn (Johnson), Bellman-Ford chỉ chạy lần đầu
+    bool reduced = type == AlgorithmType::DIJKSTRA && graph.hasNegativeWeights();
 
     int V = graph.getVertexCount();
     int startInput = 1;
@@ -170,12 +382,16 @@ static void runAlgorithm(AlgorithmType type) {
     int start = startInput - 1;
     int end = endInput - 1;
 
+    // Ghi sự kiện nhị phân; chữ chỉ được dựng cho trang đang xem
+    EventTrace trace(graph);
     PathResult result;
     auto startTime = std::chrono::high_resolution_clock::now();
-    if (type == AlgorithmType::DIJKSTRA) {
-        result = algorithms->dijkstra(start, true);
+    if (reduced) {
+        result = algorithms->johnsonDijkstra(start, trace);
+    } else if (type == AlgorithmType::DIJKSTRA) {
+        result = algorithms->dijkstra(start, trace);
     } else {
-        result = algorithms->bellmanFord(start, true);
+        result = algorithms->bellmanFord(start, trace);
     }
     auto endTime = std::chrono::high_resolution_clock::now();
     auto execUs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
@@ -195,12 +411,7 @@ static void runAlgorithm(AlgorithmType type) {
         ? "QUÁ TRÌNH THỰC HIỆN THUẬT TOÁN DIJKSTRA"
         : "QUÁ TRÌNH THỰC HIỆN THUẬT TOÁN BELLMAN-FORD";
 
-    std::vector<std::pair<int, std::string>> displayLogs;
-    std::string startLabel = graph.getVertexLabel(start);
-    std::string endLabel = graph.getVertexLabel(end);
-    displayLogs.insert(displayLogs.end(), result.logs.begin(), result.logs.end());
-
-    gui->showAlgorithmLogs(algoTitle, displayLogs);
+    gui->showAlgorithmLogs(algoTitle, trace);
 
     std::vector<std::string> lines;
     lines.push_back("Đường đi ngắn nhất từ " + graph.getVertexLabel(start) +
@@ -220,6 +431,29 @@ static void runAlgorithm(AlgorithmType type) {
         lines.push_back("Khoảng cách = " + std::to_string(dist));
         lines.push_back("Thời gian thực hiện: " + std::to_string(execUs) + " us");
     }
+    if (type == AlgorithmType::DIJKSTRA && !reduced) {
+        // chỉ cần đường start -> end: Dijkstra hai chiều không ghi log, chốt ít đỉnh hơn nhiều.
+        // CSR xuôi/ngược dựng một lần cho mỗi đồ thị (Graph::getCsr/getReverseCsr), không tính giờ
+        const CsrGraph& forward = graph.getCsr();
+        const CsrGraph& backward = graph.getReverseCsr();
+        PointToPointResult query;
+        auto queryStart = std::chrono::high_resolution_clock::now();
+        query = algorithms->bidirectionalDijkstra(forward, backward, start, end);
+        auto queryEnd = std::chrono::high_resolution_clock::now();
+        auto queryUs = std::chrono::duration_cast<std::chrono::microseconds>(queryEnd - queryStart).count();
+        lines.push_back("Dijkstra hai chiều: " + std::to_string(queryUs) + " us, chốt " +
+                        std::to_string(query.settledVertices) + "/" + std::to_string(V) + " đỉnh");
+        if (altIndex.isBuilt()) {
+            PointToPointResult altQuery;
+            auto altStart = std::chrono::high_resolution_clock::now();
+            altQuery = altIndex.query(forward, start, end);
+            auto altEnd = std::chrono::high_resolution_clock::now();
+            auto altUs = std::chrono::duration_cast<std::chrono::microseconds>(altEnd - altStart).count();
+            lines.push_back("ALT (" + std::to_string(altIndex.getLandmarkCount()) + " landmark): " +
+                            std::to_string(altUs) + " us, chốt " + std::to_string(altQuery.settledVertices) +
+                            "/" + std::to_string(V) + " đỉnh");
+        }
+    }
     if(type == AlgorithmType::DIJKSTRA){
         gui->showMessage("KẾT QUẢ THUẬT TOÁN DIJKSTRA", lines);
     } 
@@ -242,6 +476,10 @@ static void compareAlgorithms() {
     auto report = comparison->comparePerformance(start, AlgorithmType::BOTH);
     gui->drawComparisonScreen(report.logs);
     gui->waitForKey();
+
+    auto engines = comparison->compareEngines(start, Comparison::registeredEngines());
+    gui->drawComparisonScreen(engines.logs);
+    gui->waitForKey();
 }
 
 // Truyền lệnh xuất ra file python để xử lý trực quan hóa (visualizer)
@@ -357,6 +595,8 @@ static void exportToPython() {
             std::string runCmd = full;
 #endif
             lastCode = std::system(runCmd.c_str());
+            // chương trình con có thể đã in ra terminal: vẽ lại toàn bộ ở lần sau
+            invalidatedevice();
             
             if (lastCode == 0) {
                 return;
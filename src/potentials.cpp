@@ -0,0 +1,47 @@
+#include "../lib/potentials.h"
+#include "../lib/csr_graph.h"
+#include <limits>
+
+VertexPotentials computePotentials(const CsrGraph& csr) {
+    VertexPotentials result;
+    const int V = csr.getVertexCount();
+    const int* offsets = csr.getOffsets();
+    const int* targets = csr.getTargets();
+    const int* weights = csr.getWeights();
+
+    // tính bằng long long: h có thể tới -(V - 1) * |w nhỏ nhất|
+    std::vector<long long> h(V, 0);
+    bool updated = true;
+    // thêm đỉnh ảo thì có V + 1 đỉnh: V lượt là đủ, lượt thứ V + 1 còn cập nhật nghĩa là có chu trình âm
+    while (updated && result.passes <= V) {
+        updated = false;
+        result.passes++;
+        for (int u = 0; u < V; u++) {
+            const long long hu = h[u];
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                long long candidate = hu + weights[i];
+                if (candidate < h[targets[i]]) {
+                    h[targets[i]] = candidate;
+                    updated = true;
+                }
+            }
+        }
+    }
+    if (updated) {
+        result.hasNegativeCycle = true;
+        return result;
+    }
+
+    // trọng số rút gọn và khoảng cách rút gọn đều cộng thêm tối đa |h| vào giá trị gốc
+    const long long limit = std::numeric_limits<int>::max() / 4;
+    result.values.resize(V);
+    for (int v = 0; v < V; v++) {
+        if (h[v] < -limit) {
+            result.outOfRange = true;
+            result.values.clear();
+            return result;
+        }
+        result.values[v] = static_cast<int>(h[v]);
+    }
+    return result;
+}
@@ -0,0 +1,41 @@
+#include "../lib/query_workspace.h"
+#include <algorithm>
+
+QueryWorkspace::QueryWorkspace(int vertexCount) : generation(0) {
+    begin(vertexCount);
+}
+
+void QueryWorkspace::begin(int vertexCount) {
+    touched.clear();
+    heap.clear();
+    if (vertexCount != static_cast<int>(dist.size())) {
+        dist.assign(vertexCount, INF);
+        parent.assign(vertexCount, -1);
+        reached.assign(vertexCount, 0);
+        settled.assign(vertexCount, 0);
+        generation = 1;
+        return;
+    }
+    if (++generation == 0) {
+        std::fill(reached.begin(), reached.end(), 0);
+        std::fill(settled.begin(), settled.end(), 0);
+        generation = 1;
+    }
+}
+
+std::vector<int> QueryWorkspace::path(int target) const {
+    std::vector<int> result;
+    if (target < 0 || target >= getVertexCount() || !isReached(target)) return result;
+    for (int v = target; v != -1; v = parent[v]) {
+        result.push_back(v);
+        if (result.size() > dist.size()) return {};
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+long long QueryWorkspace::memoryUsageBytes() const {
+    return static_cast<long long>(dist.capacity() + parent.capacity() + touched.capacity()) * sizeof(int) +
+           static_cast<long long>(reached.capacity() + settled.capacity()) * sizeof(std::uint32_t) +
+           static_cast<long long>(heap.capacity()) * sizeof(std::pair<int, int>);
+}
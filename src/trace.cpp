@@ -0,0 +1,131 @@
+#include "../lib/trace.h"
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace {
+const int INF = std::numeric_limits<int>::max();
+} // namespace
+
+StepLogSink::StepLogSink(const Graph& g, std::vector<std::pair<int, std::string>>& output)
+    : graph(g), logs(output), engine(AlgorithmType::DIJKSTRA) {}
+
+void StepLogSink::logTable(const std::vector<int>& distances) {
+    if (distances.empty()) return;
+
+    std::ostringstream header;
+    std::ostringstream values;
+
+    header << "Đỉnh :";
+    values << "D(i) :";
+
+    for (size_t i = 0; i < distances.size(); ++i) {
+        const std::string label = graph.getVertexLabel(static_cast<int>(i));
+        header << std::setw(6) << label;
+        if (distances[i] == INF) {
+            values << std::setw(6) << "INF";
+        } else {
+            values << std::setw(6) << distances[i];
+        }
+    }
+
+    log(15, header.str());
+    log(14, values.str());
+}
+
+void StepLogSink::begin(AlgorithmType type, int start) {
+    engine = type;
+    if (engine == AlgorithmType::BELLMAN_FORD) {
+        log(14, "           ======= THUẬT TOÁN BELLMAN-FORD =======");
+    } else {
+        log(14, "              ======= THUẬT TOÁN DIJKSTRA =======");
+    }
+    log(11, "Đỉnh bắt đầu: " + graph.getVertexLabel(start));
+    log(7, "Khởi tạo khoảng cách: tất cả = INF, riêng đỉnh bắt đầu = 0");
+}
+
+void StepLogSink::beginRound(int round, int totalRounds) {
+    log(15, "");
+    log(11, "[Lượt " + std::to_string(round) + "/" + std::to_string(totalRounds) + "]");
+}
+
+void StepLogSink::settle(int round, int vertex, int distance) {
+    log(15, "");
+    log(11, "[Lần lặp " + std::to_string(round) + "]");
+    log(10, "Xử lý đỉnh: " + graph.getVertexLabel(vertex) + " (khoảng cách = " + std::to_string(distance) + ")");
+}
+
+void StepLogSink::relax(int from, int to, int distance) {
+    log(13, "  Cập nhật: " + graph.getVertexLabel(from) + " -> " + graph.getVertexLabel(to) +
+            " (khoảng cách mới = " + std::to_string(distance) + ")");
+}
+
+void StepLogSink::endRound(int round, bool updated, const std::vector<int>& distances) {
+    if (engine == AlgorithmType::BELLMAN_FORD) {
+        if (!updated) {
+            log(7, "  (Không có cập nhật ở lượt này - có thể dừng sớm)");
+        }
+        log(15, "Bảng khoảng cách sau lượt " + std::to_string(round) + ":");
+    } else {
+        log(15, "Khoảng cách sau lần lặp " + std::to_string(round) + ":");
+    }
+    logTable(distances);
+}
+
+void StepLogSink::beginCycleCheck() {
+    log(15, "");
+    log(14, "=== KIỂM TRA CHU TRÌNH ÂM ===");
+}
+
+void StepLogSink::negativeCycleEdge(int from, int to, int weight) {
+    log(12, "PHÁT HIỆN CHU TRÌNH ÂM!");
+    log(12, "Cạnh: " + graph.getVertexLabel(from) + " -> " + graph.getVertexLabel(to) +
+            " (trọng số = " + std::to_string(weight) + ")");
+}
+
+void StepLogSink::finish(const std::vector<int>& distances, bool hasNegativeCycle) {
+    const int V = static_cast<int>(distances.size());
+    if (engine == AlgorithmType::BELLMAN_FORD) {
+        if (!hasNegativeCycle) {
+            log(10, "Không phát hiện chu trình âm.");
+        }
+        log(15, "");
+        log(14, "=== KHOẢNG CÁCH CUỐI ===");
+        for (int i = 0; i < V; i++) {
+            if (distances[i] == INF) {
+                log(11, graph.getVertexLabel(i) + " = INF (không tới được)");
+            } else {
+                log(11, graph.getVertexLabel(i) + " = " + std::to_string(distances[i]));
+            }
+        }
+        return;
+    }
+
+    log(15, "");
+    log(14, "                  === KHOẢNG CÁCH CUỐI ===");
+    for (int i = 0; i < V; i++) {
+        if (distances[i] == INF) {
+            log(11, "dist[" + std::to_string(i + 1) + "] = INF (không tồn tại đường đi)");
+        } else {
+            log(11, "dist[" + std::to_string(i + 1) + "] = " + std::to_string(distances[i]));
+        }
+    }
+}
+
+void StepLogSink::reweighted(int bellmanFordPasses) {
+    log(7, "Trọng số rút gọn w + h(u) - h(v) >= 0 theo thế năng Johnson (" +
+           std::to_string(bellmanFordPasses) + " lượt Bellman-Ford, đã lưu)");
+}
+
+void StepLogSink::restored(const std::vector<int>& distances) {
+    log(15, "");
+    log(14, "=== KHOẢNG CÁCH GỐC (d = d' - h(s) + h(v)) ===");
+    for (size_t v = 0; v < distances.size(); v++) {
+        const std::string label = graph.getVertexLabel(static_cast<int>(v));
+        if (distances[v] == INF) {
+            log(11, label + " = INF (không tới được)");
+        } else {
+            log(11, label + " = " + std::to_string(distances[v]));
+        }
+    }
+}